@@ -150,6 +150,27 @@ ByteString StandardPaths::config_directory()
     return LexicalPath::canonicalized_path(builder.to_byte_string());
 }
 
+ByteString StandardPaths::cache_directory()
+{
+#ifdef AK_OS_WINDOWS
+    return ByteString::formatted("{}"sv, getenv("LOCALAPPDATA"));
+#endif
+    if (auto cache_directory = get_environment_if_not_empty("XDG_CACHE_HOME"sv); cache_directory.has_value())
+        return LexicalPath::canonicalized_path(*cache_directory);
+
+    StringBuilder builder;
+    builder.append(home_directory());
+#if defined(AK_OS_MACOS)
+    builder.append("/Library/Caches"sv);
+#elif defined(AK_OS_HAIKU)
+    builder.append("/config/cache"sv);
+#else
+    builder.append("/.cache"sv);
+#endif
+
+    return LexicalPath::canonicalized_path(builder.to_byte_string());
+}
+
 ByteString StandardPaths::user_data_directory()
 {
 #ifdef AK_OS_WINDOWS
@@ -23,6 +23,7 @@ public:
     static ByteString videos_directory();
     static ByteString tempfile_directory();
     static ByteString config_directory();
+    static ByteString cache_directory();
     static ByteString user_data_directory();
     static Vector<ByteString> system_data_directories();
     static ErrorOr<ByteString> runtime_directory();
@@ -32,6 +32,7 @@ namespace GC {
 
 BlockAllocator::~BlockAllocator()
 {
+    m_blocks.extend(move(m_unused_resident_blocks));
     for (auto* block : m_blocks) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
 #if !defined(AK_OS_WINDOWS)
@@ -50,6 +51,15 @@ BlockAllocator::~BlockAllocator()
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
+    // OPTIMIZATION: Prefer blocks that are still resident, as they can be reused without taking page faults.
+    if (!m_unused_resident_blocks.is_empty()) {
+        size_t random_index = get_random_uniform(m_unused_resident_blocks.size());
+        auto* block = m_unused_resident_blocks.unstable_take(random_index);
+        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
+        LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
+        return block;
+    }
+
     if (!m_blocks.is_empty()) {
         // To reduce predictability, take a random block from the cache.
         size_t random_index = get_random_uniform(m_blocks.size());
@@ -74,6 +84,32 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
+    // NOTE: Returning the pages to the OS is deferred until decommit_unused_blocks(), which saves a syscall
+    //       (and subsequent page faults) for every block that gets reused before then.
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+
+    // NOTE: Only a few blocks are kept resident, so a collection that frees lots of them doesn't hold on to their
+    //       memory until the next call to decommit_unused_blocks().
+    if (m_unused_resident_blocks.size() >= max_unused_resident_blocks) {
+        decommit_block(block);
+        m_blocks.append(block);
+        return;
+    }
+    m_unused_resident_blocks.append(block);
+}
+
+void BlockAllocator::decommit_unused_blocks()
+{
+    for (auto* block : m_unused_resident_blocks) {
+        decommit_block(block);
+        m_blocks.append(block);
+    }
+    m_unused_resident_blocks.clear_with_capacity();
+}
+
+void BlockAllocator::decommit_block(void* block)
+{
 #if defined(AK_OS_WINDOWS)
     DWORD ret = DiscardVirtualMemory(block, HeapBlock::block_size);
     if (ret != ERROR_SUCCESS) {
@@ -101,10 +137,6 @@ void BlockAllocator::deallocate_block(void* block)
         VERIFY_NOT_REACHED();
     }
 #endif
-
-    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
-    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
 }
 
 }
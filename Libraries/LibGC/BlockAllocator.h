@@ -19,8 +19,18 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    // Returns the physical pages of blocks that were deallocated but not reused since the last call to the OS.
+    void decommit_unused_blocks();
+
 private:
+    void decommit_block(void*);
+
+    // Blocks whose pages have been returned to the OS.
     Vector<void*> m_blocks;
+
+    // Blocks that were deallocated recently and are still resident, so reusing them doesn't fault.
+    static constexpr size_t max_unused_resident_blocks = 8;
+    Vector<void*> m_unused_resident_blocks;
 };
 
 }
@@ -55,4 +55,13 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_did_become_sparse(Badge<Heap>, HeapBlock& block)
+{
+    VERIFY(!block.is_full());
+    // NOTE: We allocate from the back of the usable block list, so moving a sparse block to the front lets its
+    //       remaining cells die off without new neighbors, after which the whole block goes back to the
+    //       BlockAllocator and gets decommitted once it has stayed unused for a while.
+    m_usable_blocks.prepend(block);
+}
+
 }
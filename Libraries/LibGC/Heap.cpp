@@ -15,6 +15,8 @@
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapBlock.h>
@@ -33,17 +35,17 @@ Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)>
     , m_gather_embedder_roots(move(gather_embedder_roots))
 {
     static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
-    m_size_based_cell_allocators.append(make<CellAllocator>(64));
-    m_size_based_cell_allocators.append(make<CellAllocator>(96));
-    m_size_based_cell_allocators.append(make<CellAllocator>(128));
-    m_size_based_cell_allocators.append(make<CellAllocator>(256));
-    m_size_based_cell_allocators.append(make<CellAllocator>(512));
-    m_size_based_cell_allocators.append(make<CellAllocator>(1024));
-    m_size_based_cell_allocators.append(make<CellAllocator>(3072));
+    for (auto cell_size : size_based_cell_allocator_sizes)
+        m_size_based_cell_allocators.append(make<CellAllocator>(cell_size));
 }
 
 Heap::~Heap()
 {
+    // NOTE: The event loop of this thread may already be gone, so the final collection must not schedule anything on
+    //       it. The block allocators unmap all of their blocks once we're gone anyway.
+    m_is_being_destroyed = true;
+    if (m_decommit_unused_blocks_timer)
+        m_decommit_unused_blocks_timer->stop();
     collect_garbage(CollectionType::CollectEverything);
 }
 
@@ -111,14 +113,11 @@ static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& a
 
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
-    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
         for (auto& [root, root_origin] : roots) {
@@ -223,16 +222,17 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
 AK::JsonObject Heap::dump_graph()
 {
+    auto all_live_heap_blocks = gather_all_live_heap_blocks();
     HashMap<Cell*, HeapRoot> roots;
-    gather_roots(roots);
-    GraphConstructorVisitor visitor(*this, roots);
+    gather_roots(roots, all_live_heap_blocks);
+    GraphConstructorVisitor visitor(*this, roots, all_live_heap_blocks);
     visitor.visit_all_cells();
     return visitor.dump();
 }
@@ -244,37 +244,107 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     {
         TemporaryChange change(m_collecting_garbage, true);
 
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
         if (collection_type == CollectionType::CollectGarbage) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
+            // NOTE: The set of live blocks cannot change until we start sweeping, so it's shared
+            //       between conservative root scanning and marking instead of being rebuilt for each.
+            auto all_live_heap_blocks = gather_all_live_heap_blocks();
             HashMap<Cell*, HeapRoot> roots;
-            gather_roots(roots);
-            mark_live_cells(roots);
+            gather_roots(roots, all_live_heap_blocks);
+            mark_live_cells(roots, all_live_heap_blocks);
         }
         finalize_unmarked_cells();
         sweep_dead_cells(print_report, collection_measurement_timer);
+
+        record_collection_pause(collection_measurement_timer.elapsed_time());
+        if (print_report)
+            dump_collection_pause_histogram();
     }
 
+    if (!m_is_being_destroyed)
+        schedule_decommit_of_unused_blocks();
+
     auto tasks = move(m_post_gc_tasks);
     for (auto& task : tasks)
         task();
 }
 
+void Heap::schedule_decommit_of_unused_blocks()
+{
+    // NOTE: Without an event loop, the timer would never fire, so the blocks are returned to the OS right away.
+    if (!Core::EventLoop::is_running()) {
+        decommit_unused_blocks();
+        return;
+    }
+
+    // NOTE: Blocks freed by this collection stay resident for a short while, so that allocations shortly after
+    //       the collection can reuse them without faulting pages back in. Whatever is still unused when the timer
+    //       fires gets decommitted then, outside of the collection pause. The timer is not restarted by later
+    //       collections, so frequent collections can't keep unused blocks resident forever.
+    if (!m_decommit_unused_blocks_timer) {
+        m_decommit_unused_blocks_timer = Core::Timer::create_single_shot(decommit_unused_blocks_delay_ms, [this] {
+            decommit_unused_blocks();
+        });
+    }
+    if (!m_decommit_unused_blocks_timer->is_active())
+        m_decommit_unused_blocks_timer->start();
+}
+
+void Heap::decommit_unused_blocks()
+{
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.block_allocator().decommit_unused_blocks();
+}
+
+void Heap::record_collection_pause(AK::Duration pause)
+{
+    ++m_collection_count;
+    m_longest_collection_pause = max(m_longest_collection_pause, pause);
+
+    auto milliseconds = static_cast<u64>(pause.to_milliseconds());
+    size_t bucket = 0;
+    while (bucket < number_of_pause_histogram_buckets - 1 && milliseconds >= (1ull << bucket))
+        ++bucket;
+    ++m_collection_pause_histogram[bucket];
+}
+
+void Heap::dump_collection_pause_histogram() const
+{
+    dbgln("Garbage collection pauses ({} collections, longest {} ms)", m_collection_count, m_longest_collection_pause.to_milliseconds());
+    dbgln("=============================================");
+    for (size_t bucket = 0; bucket < number_of_pause_histogram_buckets; ++bucket) {
+        if (bucket == number_of_pause_histogram_buckets - 1)
+            dbgln("   >= {:4} ms: {}", 1ull << (bucket - 1), m_collection_pause_histogram[bucket]);
+        else
+            dbgln("    < {:4} ms: {}", 1ull << bucket, m_collection_pause_histogram[bucket]);
+    }
+    dbgln("=============================================");
+}
+
 void Heap::enqueue_post_gc_task(AK::Function<void()> task)
 {
     m_post_gc_tasks.append(move(task));
 }
 
-void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
+HashTable<HeapBlock*> Heap::gather_all_live_heap_blocks()
+{
+    HashTable<HeapBlock*> all_live_heap_blocks;
+    for_each_block([&](auto& block) {
+        all_live_heap_blocks.set(&block);
+        return IterationDecision::Continue;
+    });
+    return all_live_heap_blocks;
+}
+
+void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     m_gather_embedder_roots(roots);
-    gather_conservative_roots(roots);
+    gather_conservative_roots(roots, all_live_heap_blocks);
 
     for (auto& root : m_roots)
         roots.set(root.cell(), HeapRoot { .type = HeapRoot::Type::Root, .location = &root.source_location() });
@@ -314,7 +384,7 @@ void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, Fl
 }
 #endif
 
-NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
+NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     FlatPtr dummy;
 
@@ -347,12 +417,6 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
     for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
@@ -365,14 +429,12 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
+        m_work_queue.ensure_capacity(roots.size());
 
         for (auto* root : roots.keys()) {
             visit(root);
@@ -417,16 +479,16 @@ public:
 private:
     Heap& m_heap;
     Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(*this, roots, all_live_heap_blocks);
 
     visitor.mark_all_live_cells();
 
@@ -465,16 +527,20 @@ void Heap::finalize_unmarked_cells()
 void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
+
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+    Vector<HeapBlock*, 32> sparse_blocks;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t free_cell_bytes_in_live_blocks = 0;
+    size_t never_allocated_cell_bytes_in_live_blocks = 0;
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
+        size_t block_live_cells = 0;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked()) {
@@ -484,15 +550,28 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
-                block_has_live_cells = true;
+                ++block_live_cells;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        if (!block_live_cells) {
             empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
+            return IterationDecision::Continue;
+        }
+        if (block_was_full != block.is_full()) {
+            // NOTE: Only blocks that were completely filled up before are considered sparse, since a block we are
+            //       still bump-allocating from would otherwise look sparse too.
+            if (block_live_cells <= block.cell_count() / 4)
+                sparse_blocks.append(&block);
+            else
+                full_blocks_that_became_usable.append(&block);
+        }
+        // NOTE: Cells that have never been allocated are not on the freelist, and their pages may not even be resident,
+        //       so they are counted separately.
+        auto never_allocated_cells = block.never_allocated_cell_count();
+        free_cell_bytes_in_live_blocks += (block.cell_count() - never_allocated_cells - block_live_cells) * block.cell_size();
+        never_allocated_cell_bytes_in_live_blocks += never_allocated_cells * block.cell_size();
         return IterationDecision::Continue;
     });
 
@@ -509,6 +588,11 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         block->cell_allocator().block_did_become_usable({}, *block);
     }
 
+    for (auto* block : sparse_blocks) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock sparse @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_sparse({}, *block);
+    }
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -533,6 +617,9 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("  Sparse blocks: {} ({} bytes)", sparse_blocks.size(), sparse_blocks.size() * HeapBlock::block_size);
+        dbgln("Free cell bytes: {} (on freelists of live blocks)", free_cell_bytes_in_live_blocks);
+        dbgln("Untouched bytes: {} (never allocated in live blocks)", never_allocated_cell_bytes_in_live_blocks);
         dbgln("=============================================");
     }
 }
@@ -6,14 +6,17 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/RefPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -82,6 +85,8 @@ public:
 
     void enqueue_post_gc_task(AK::Function<void()>);
 
+    size_t collection_count() const { return m_collection_count; }
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
@@ -102,26 +107,57 @@ private:
                 return T::cell_allocator.allocator.get().allocate_cell(*this);
             }
         }
+        // OPTIMIZATION: The size class of a cell type is known at compile time, so we can skip the table lookup entirely.
+        constexpr auto size_class = size_class_for_size(sizeof(T));
+        if constexpr (size_class < size_based_cell_allocator_sizes.size())
+            return m_size_based_cell_allocators[size_class]->allocate_cell(*this);
         return allocator_for_size(sizeof(T)).allocate_cell(*this);
     }
 
     void will_allocate(size_t);
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
-    void gather_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
+    HashTable<HeapBlock*> gather_all_live_heap_blocks();
+    void gather_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
+    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, HashTable<HeapBlock*> const& all_live_heap_blocks);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
 
+    void schedule_decommit_of_unused_blocks();
+    void decommit_unused_blocks();
+
+    void record_collection_pause(AK::Duration);
+    void dump_collection_pause_histogram() const;
+
+    static constexpr Array<size_t, 7> size_based_cell_allocator_sizes { 64, 96, 128, 256, 512, 1024, 3072 };
+    static constexpr size_t size_class_granularity = 16;
+
+    // Maps a cell size (rounded up to size_class_granularity) to the index of the smallest size class that fits it.
+    static constexpr auto size_class_lookup_table = [] {
+        Array<u8, size_based_cell_allocator_sizes.last() / size_class_granularity + 1> table {};
+        size_t size_class = 0;
+        for (size_t i = 0; i < table.size(); ++i) {
+            while (size_based_cell_allocator_sizes[size_class] < i * size_class_granularity)
+                ++size_class;
+            table[i] = size_class;
+        }
+        return table;
+    }();
+
+    static constexpr size_t size_class_for_size(size_t cell_size)
+    {
+        if (cell_size > size_based_cell_allocator_sizes.last())
+            return size_based_cell_allocator_sizes.size();
+        return size_class_lookup_table[(cell_size + size_class_granularity - 1) / size_class_granularity];
+    }
+
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
-        // FIXME: Use binary search?
-        for (auto& allocator : m_size_based_cell_allocators) {
-            if (allocator->cell_size() >= cell_size)
-                return *allocator;
-        }
+        auto size_class = size_class_for_size(cell_size);
+        if (size_class < m_size_based_cell_allocators.size()) [[likely]]
+            return *m_size_based_cell_allocators[size_class];
         dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, m_size_based_cell_allocators.last()->cell_size());
         VERIFY_NOT_REACHED();
     }
@@ -141,6 +177,12 @@ private:
 
     bool m_should_collect_on_every_allocation { false };
 
+    // Bucket N counts pauses shorter than 2^N ms; the last bucket collects everything longer.
+    static constexpr size_t number_of_pause_histogram_buckets = 10;
+    Array<size_t, number_of_pause_histogram_buckets> m_collection_pause_histogram {};
+    AK::Duration m_longest_collection_pause;
+    size_t m_collection_count { 0 };
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
@@ -160,6 +202,10 @@ private:
     AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> m_gather_embedder_roots;
 
     Vector<AK::Function<void()>> m_post_gc_tasks;
+
+    static constexpr int decommit_unused_blocks_delay_ms = 1000;
+    RefPtr<Core::Timer> m_decommit_unused_blocks_timer;
+    bool m_is_being_destroyed { false };
 } SWIFT_IMMORTAL_REFERENCE;
 
 inline void Heap::did_create_root(Badge<RootImpl>, RootImpl& impl)
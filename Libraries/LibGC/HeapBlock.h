@@ -32,6 +32,9 @@ public:
     size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
     bool is_full() const { return !has_lazy_freelist() && !m_freelist; }
 
+    // The cells at the end of the block that have never been handed out, and thus have never been touched.
+    size_t never_allocated_cell_count() const { return cell_count() - m_next_lazy_freelist_index; }
+
     ALWAYS_INLINE Cell* allocate()
     {
         Cell* allocated_cell = nullptr;
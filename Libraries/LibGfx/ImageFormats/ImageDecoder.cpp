@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Math.h>
 #include <LibGfx/ImageFormats/AVIFLoader.h>
 #include <LibGfx/ImageFormats/BMPLoader.h>
 #include <LibGfx/ImageFormats/GIFLoader.h>
@@ -47,6 +48,37 @@ static ErrorOr<OwnPtr<ImageDecoderPlugin>> probe_and_sniff_for_appropriate_plugi
     return OwnPtr<ImageDecoderPlugin> {};
 }
 
+int ImageDecoderPlugin::scale_down_factor_for_ideal_size(IntSize natural_size, Optional<IntSize> ideal_size, int maximum_factor)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || natural_size.is_empty())
+        return 1;
+
+    auto covers_ideal_size = [&](int factor) {
+        return ceil_div(natural_size.width(), factor) >= ideal_size->width()
+            && ceil_div(natural_size.height(), factor) >= ideal_size->height();
+    };
+
+    int factor = 1;
+    while (factor * 2 <= maximum_factor && covers_ideal_size(factor * 2))
+        factor *= 2;
+    return factor;
+}
+
+IntSize ImageDecoderPlugin::scaled_size_for_ideal_size(IntSize natural_size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || natural_size.is_empty())
+        return natural_size;
+
+    auto scale = max(static_cast<double>(ideal_size->width()) / natural_size.width(), static_cast<double>(ideal_size->height()) / natural_size.height());
+    if (scale >= 1)
+        return natural_size;
+
+    return {
+        min(natural_size.width(), static_cast<int>(ceil(natural_size.width() * scale))),
+        min(natural_size.height(), static_cast<int>(ceil(natural_size.height() * scale))),
+    };
+}
+
 ErrorOr<ColorSpace> ImageDecoder::color_space()
 {
     auto maybe_cicp = TRY(m_plugin->cicp());
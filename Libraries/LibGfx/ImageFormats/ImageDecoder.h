@@ -83,8 +83,15 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // If an ideal size is given, plugins that can decode at a lower resolution may return a bitmap that is smaller
+    // than size(), but never smaller than the ideal size.
+    // FIXME: Allow decoding only a region of the image, e.g. for images that are mostly clipped or scrolled out of view.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if the format can be decoded from data that is cut off, e.g. because it is still being downloaded.
+    // The result is a bitmap of the full size of the first frame, containing everything that could be decoded so far.
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame() { return Error::from_string_literal("Partial decoding is not supported"); }
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<Media::CodingIndependentCodePoints>> cicp() { return OptionalNone {}; }
@@ -96,6 +103,14 @@ public:
 
 protected:
     ImageDecoderPlugin() = default;
+
+    // Returns the largest power of two up to maximum_factor that the natural size can be divided by, while still
+    // covering the ideal size.
+    static int scale_down_factor_for_ideal_size(IntSize natural_size, Optional<IntSize> ideal_size, int maximum_factor);
+
+    // Returns the smallest size with the aspect ratio of the natural size that covers the ideal size, or the natural
+    // size itself if that is smaller.
+    static IntSize scaled_size_for_ideal_size(IntSize natural_size, Optional<IntSize> ideal_size);
 };
 
 class ImageDecoder : public RefCounted<ImageDecoder> {
@@ -112,6 +127,7 @@ public:
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    ErrorOr<ImageFrameDescriptor> partial_frame() const { return m_plugin->partial_frame(); }
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<ColorSpace> color_space();
@@ -18,11 +18,19 @@ struct JPEGLoadingContext {
     enum class State {
         NotDecoded,
         Error,
+        HeaderDecoded,
         Decoded,
     };
 
     State state { State::NotDecoded };
 
+    IntSize size;
+    bool is_cmyk { false };
+
+    // libjpeg can skip most of the work of decoding an image at 1/2, 1/4 or 1/8 of its size by scaling the DCT.
+    static constexpr int maximum_scale_down_factor = 8;
+    int decoded_scale_down_factor { 1 };
+
     RefPtr<Gfx::Bitmap> rgb_bitmap;
     RefPtr<Gfx::CMYKBitmap> cmyk_bitmap;
     OwnPtr<ExifMetadata> exif_metadata;
@@ -30,19 +38,26 @@ struct JPEGLoadingContext {
     ReadonlyBytes data;
     Vector<u8> icc_data;
 
+    // If the data may be cut off, we decode as much of it as we can, e.g. to show an image while it is loading.
+    bool is_data_complete { true };
+
     JPEGLoadingContext(ReadonlyBytes data)
         : data(data)
     {
     }
 
-    ErrorOr<void> decode();
+    enum class Mode {
+        HeaderOnly,
+        Full,
+    };
+    ErrorOr<void> decode(Mode, int scale_down_factor = 1);
 };
 
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+ErrorOr<void> JPEGLoadingContext::decode(Mode mode, int scale_down_factor)
 {
     struct jpeg_decompress_struct cinfo;
     ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
@@ -62,12 +77,27 @@ ErrorOr<void> JPEGLoadingContext::decode()
         longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
     };
 
+    // NOTE: Running out of data is expected when decoding incomplete data, so don't warn about it every time.
+    if (!is_data_complete)
+        jerr.emit_message = [](j_common_ptr, int) { };
+
     jpeg_create_decompress(&cinfo);
 
     source_manager.next_input_byte = data.data();
     source_manager.bytes_in_buffer = data.size();
     source_manager.init_source = [](j_decompress_ptr) { };
-    source_manager.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+    if (is_data_complete) {
+        source_manager.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+    } else {
+        // NOTE: Pretend that the image ends where the data does, so that libjpeg outputs everything it has decoded so far,
+        //       i.e. the rows of a baseline image or the scans of a progressive image that we have the data for.
+        source_manager.fill_input_buffer = [](j_decompress_ptr context) -> boolean {
+            static constexpr JOCTET end_of_image[] = { 0xFF, JPEG_EOI };
+            context->src->next_input_byte = end_of_image;
+            context->src->bytes_in_buffer = sizeof(end_of_image);
+            return TRUE;
+        };
+    }
     source_manager.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
         if (num_bytes > static_cast<long>(context->src->bytes_in_buffer)) {
             context->src->bytes_in_buffer = 0;
@@ -95,21 +125,51 @@ ErrorOr<void> JPEGLoadingContext::decode()
         cinfo.out_color_space = JCS_EXT_BGRX;
     }
 
-    auto marker = cinfo.marker_list;
-    while (marker) {
-        constexpr auto expected_length = sizeof("Exif\0\0") - 1;
-        if (marker->marker == jpeg_app1 && marker->data_length >= expected_length) {
-            constexpr auto expected = "Exif\0\0"sv;
+    if (state < State::HeaderDecoded) {
+        size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+        is_cmyk = cinfo.out_color_space != JCS_EXT_BGRX;
 
-            auto signature = StringView { marker->data, expected_length };
-            if (signature == expected) {
-                exif_metadata = TRY(TIFFImageDecoderPlugin::read_exif_metadata({ marker->data + expected_length, marker->original_length - expected_length }));
-                break;
+        auto marker = cinfo.marker_list;
+        while (marker) {
+            constexpr auto expected_length = sizeof("Exif\0\0") - 1;
+            if (marker->marker == jpeg_app1 && marker->data_length >= expected_length) {
+                constexpr auto expected = "Exif\0\0"sv;
+
+                auto signature = StringView { marker->data, expected_length };
+                if (signature == expected) {
+                    exif_metadata = TRY(TIFFImageDecoderPlugin::read_exif_metadata({ marker->data + expected_length, marker->original_length - expected_length }));
+                    break;
+                }
             }
+
+            marker = marker->next;
+        }
+
+        JOCTET* icc_data_ptr = nullptr;
+        unsigned int icc_data_length = 0;
+        if (jpeg_read_icc_profile(&cinfo, &icc_data_ptr, &icc_data_length)) {
+            icc_data.resize(icc_data_length);
+            memcpy(icc_data.data(), icc_data_ptr, icc_data_length);
+            free(icc_data_ptr);
         }
 
-        marker = marker->next;
+        state = State::HeaderDecoded;
+    }
+
+    if (mode == Mode::HeaderOnly)
+        return {};
+
+    // NOTE: CMYK images are also handed out through cmyk_frame(), which is expected to be at the natural size.
+    if (!is_cmyk && scale_down_factor > 1) {
+        cinfo.scale_num = 1;
+        cinfo.scale_denom = scale_down_factor;
+    } else {
+        scale_down_factor = 1;
     }
+    decoded_scale_down_factor = scale_down_factor;
+
+    rgb_bitmap = nullptr;
+    cmyk_bitmap = nullptr;
 
     jpeg_start_decompress(&cinfo);
     bool could_read_all_scanlines = true;
@@ -170,14 +230,6 @@ ErrorOr<void> JPEGLoadingContext::decode()
         }
     }
 
-    JOCTET* icc_data_ptr = nullptr;
-    unsigned int icc_data_length = 0;
-    if (jpeg_read_icc_profile(&cinfo, &icc_data_ptr, &icc_data_length)) {
-        icc_data.resize(icc_data_length);
-        memcpy(icc_data.data(), icc_data_ptr, icc_data_length);
-        free(icc_data_ptr);
-    }
-
     if (could_read_all_scanlines)
         jpeg_finish_decompress(&cinfo);
     else
@@ -196,20 +248,28 @@ JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>
 
 JPEGImageDecoderPlugin::~JPEGImageDecoderPlugin() = default;
 
-IntSize JPEGImageDecoderPlugin::size()
+ErrorOr<void> JPEGImageDecoderPlugin::decode_header_if_needed()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)frame(0);
-
     if (m_context->state == JPEGLoadingContext::State::Error)
-        return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
+
+    if (m_context->state == JPEGLoadingContext::State::NotDecoded) {
+        if (auto result = m_context->decode(JPEGLoadingContext::Mode::HeaderOnly); result.is_error()) {
+            m_context->state = JPEGLoadingContext::State::Error;
+            return result.release_error();
+        }
+    }
+
     return {};
 }
 
+IntSize JPEGImageDecoderPlugin::size()
+{
+    if (decode_header_if_needed().is_error())
+        return {};
+    return m_context->size;
+}
+
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
 {
     return data.size() > 3
@@ -223,16 +283,19 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
 
-    if (m_context->state == JPEGLoadingContext::State::Error)
-        return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
+    TRY(decode_header_if_needed());
 
-    if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        if (auto result = m_context->decode(); result.is_error()) {
+    // OPTIMIZATION: Decoding a large photo at the size it is displayed at saves most of the work and memory.
+    auto scale_down_factor = scale_down_factor_for_ideal_size(m_context->size, ideal_size, JPEGLoadingContext::maximum_scale_down_factor);
+
+    // NOTE: If we already decoded at a lower resolution than what is asked for now, we have to decode again.
+    if (m_context->state < JPEGLoadingContext::State::Decoded || scale_down_factor < m_context->decoded_scale_down_factor) {
+        if (auto result = m_context->decode(JPEGLoadingContext::Mode::Full, scale_down_factor); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
         }
@@ -243,8 +306,24 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     return ImageFrameDescriptor { m_context->rgb_bitmap, 0 };
 }
 
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::partial_frame()
+{
+    TRY(decode_header_if_needed());
+
+    // NOTE: Decode into a separate context, so that the partial image is never mistaken for the complete one.
+    JPEGLoadingContext context { m_context->data };
+    context.is_data_complete = false;
+    TRY(context.decode(JPEGLoadingContext::Mode::Full));
+
+    if (!context.rgb_bitmap)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Partial decoding failed");
+    return ImageFrameDescriptor { context.rgb_bitmap, 0 };
+}
+
 Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 {
+    (void)decode_header_if_needed();
+
     if (m_context->exif_metadata)
         return *m_context->exif_metadata;
 
@@ -253,8 +332,7 @@ Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 
 ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)frame(0);
+    TRY(decode_header_if_needed());
 
     if (!m_context->icc_data.is_empty())
         return m_context->icc_data;
@@ -263,17 +341,16 @@ ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 
 NaturalFrameFormat JPEGImageDecoderPlugin::natural_frame_format() const
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)const_cast<JPEGImageDecoderPlugin&>(*this).frame(0);
+    (void)const_cast<JPEGImageDecoderPlugin&>(*this).decode_header_if_needed();
 
-    if (m_context->cmyk_bitmap)
+    if (m_context->is_cmyk)
         return NaturalFrameFormat::CMYK;
     return NaturalFrameFormat::RGB;
 }
 
 ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
+    if (m_context->state < JPEGLoadingContext::State::Decoded)
         (void)frame(0);
 
     if (m_context->state == JPEGLoadingContext::State::Error)
@@ -21,6 +21,7 @@ public:
     virtual IntSize size() override;
 
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame() override;
 
     virtual Optional<Metadata const&> metadata() override;
 
@@ -32,6 +33,8 @@ public:
 private:
     explicit JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
 
+    ErrorOr<void> decode_header_if_needed();
+
     NonnullOwnPtr<JPEGLoadingContext> m_context;
 };
 
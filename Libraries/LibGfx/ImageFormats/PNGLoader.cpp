@@ -26,8 +26,10 @@ struct PNGLoadingContext {
     png_structp png_ptr { nullptr };
     png_infop info_ptr { nullptr };
 
+    ReadonlyBytes encoded_data;
     ReadonlyBytes data;
     IntSize size;
+    bool is_interlaced { false };
     u32 frame_count { 0 };
     u32 loop_count { 0 };
     Vector<ImageFrameDescriptor> frame_descriptors;
@@ -35,7 +37,17 @@ struct PNGLoadingContext {
     Optional<ByteBuffer> icc_profile;
     OwnPtr<ExifMetadata> exif_metadata;
 
+    // Images without animation are only decoded once frame() is called, so that they can be decoded at a lower
+    // resolution if a smaller size is asked for.
+    static constexpr int maximum_scale_down_factor = 8;
+    bool is_decoded_lazily { false };
+    int decoded_scale_down_factor { 1 };
+
+    // The bitmap that rows are currently being read into. If the data is cut off, this holds the rows read so far.
+    RefPtr<Bitmap> frame_being_decoded;
+
     ErrorOr<size_t> read_frames(png_structp, png_infop);
+    ErrorOr<NonnullRefPtr<Bitmap>> read_scaled_down_frame(png_structp, int scale_down_factor);
 
     ErrorOr<void> read_all_frames()
     {
@@ -50,6 +62,24 @@ struct PNGLoadingContext {
 
         return {};
     }
+
+    ErrorOr<void> read_single_frame(int scale_down_factor)
+    {
+        // NOTE: We need to setjmp() here because libpng uses longjmp() for error handling.
+        if (auto error_value = setjmp(png_jmpbuf(png_ptr)); error_value) {
+            return Error::from_errno(error_value);
+        }
+
+        png_read_update_info(png_ptr, info_ptr);
+
+        if (scale_down_factor == 1) {
+            frame_count = TRY(read_frames(png_ptr, info_ptr));
+            return {};
+        }
+
+        frame_descriptors.append({ TRY(read_scaled_down_frame(png_ptr, scale_down_factor)), 0 });
+        return {};
+    }
 };
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> PNGImageDecoderPlugin::create(ReadonlyBytes bytes)
@@ -57,6 +87,14 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> PNGImageDecoderPlugin::create(Readonl
     auto decoder = adopt_own(*new PNGImageDecoderPlugin(bytes));
     TRY(decoder->initialize());
 
+    u32 animation_frame_count = 0;
+    u32 animation_loop_count = 0;
+    if (!png_get_acTL(decoder->m_context->png_ptr, decoder->m_context->info_ptr, &animation_frame_count, &animation_loop_count)) {
+        decoder->m_context->is_decoded_lazily = true;
+        decoder->m_context->frame_count = 1;
+        return decoder;
+    }
+
     auto result = decoder->m_context->read_all_frames();
     if (result.is_error()) {
         // NOTE: If we didn't fail in initialize(), that means we have size information.
@@ -74,9 +112,34 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> PNGImageDecoderPlugin::create(Readonl
 PNGImageDecoderPlugin::PNGImageDecoderPlugin(ReadonlyBytes data)
     : m_context(adopt_own(*new PNGLoadingContext))
 {
+    m_context->encoded_data = data;
     m_context->data = data;
 }
 
+ErrorOr<void> PNGImageDecoderPlugin::decode_single_frame(int scale_down_factor)
+{
+    // NOTE: libpng can only read the image data once, so start over if we have to decode at a higher resolution.
+    if (!m_context->frame_descriptors.is_empty()) {
+        png_destroy_read_struct(&m_context->png_ptr, &m_context->info_ptr, nullptr);
+        m_context->frame_descriptors.clear();
+        m_context->data = m_context->encoded_data;
+        TRY(initialize());
+    }
+
+    m_context->decoded_scale_down_factor = scale_down_factor;
+
+    if (auto result = m_context->read_single_frame(scale_down_factor); result.is_error()) {
+        // NOTE: Just like in create(), fall back to a blank bitmap of the right size.
+        m_context->frame_descriptors.clear();
+        auto bitmap_size = IntSize { ceil_div(m_context->size.width(), scale_down_factor), ceil_div(m_context->size.height(), scale_down_factor) };
+        auto bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Premultiplied, bitmap_size));
+        m_context->frame_descriptors.append({ move(bitmap), 0 });
+        m_context->frame_count = 1;
+    }
+
+    return {};
+}
+
 size_t PNGImageDecoderPlugin::first_animated_frame_index()
 {
     return 0;
@@ -102,14 +165,47 @@ size_t PNGImageDecoderPlugin::frame_count()
     return m_context->frame_count;
 }
 
-ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
+    if (m_context->is_decoded_lazily && index == 0) {
+        // OPTIMIZATION: Averaging blocks of pixels while reading the rows means that we never need to hold the image
+        //               at its full resolution in memory. Interlaced images need all of their rows at once though.
+        auto scale_down_factor = 1;
+        if (!m_context->is_interlaced)
+            scale_down_factor = scale_down_factor_for_ideal_size(m_context->size, ideal_size, PNGLoadingContext::maximum_scale_down_factor);
+
+        if (m_context->frame_descriptors.is_empty() || scale_down_factor < m_context->decoded_scale_down_factor)
+            TRY(decode_single_frame(scale_down_factor));
+    }
+
     if (index >= m_context->frame_descriptors.size())
         return Error::from_errno(EINVAL);
 
     return m_context->frame_descriptors[index];
 }
 
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::partial_frame()
+{
+    if (!m_context->is_decoded_lazily)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Partial decoding of animated images is not supported");
+
+    // NOTE: Decode with a separate decoder, so that the partial image is never mistaken for the complete one.
+    PNGImageDecoderPlugin partial_decoder { m_context->encoded_data };
+    TRY(partial_decoder.initialize());
+
+    auto& context = *partial_decoder.m_context;
+    if (auto result = context.read_single_frame(1); result.is_error()) {
+        // NOTE: libpng bails out once it runs out of data, but the rows it has read are already in the bitmap.
+        if (!context.frame_being_decoded)
+            return result.release_error();
+        return ImageFrameDescriptor { context.frame_being_decoded, 0 };
+    }
+
+    if (context.frame_descriptors.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Partial decoding failed");
+    return context.frame_descriptors.first();
+}
+
 ErrorOr<Optional<Media::CodingIndependentCodePoints>> PNGImageDecoderPlugin::cicp()
 {
     return m_context->cicp;
@@ -169,6 +265,7 @@ ErrorOr<void> PNGImageDecoderPlugin::initialize()
     int interlace_type = 0;
     png_get_IHDR(m_context->png_ptr, m_context->info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
     m_context->size = { static_cast<int>(width), static_cast<int>(height) };
+    m_context->is_interlaced = interlace_type != PNG_INTERLACE_NONE;
 
     if (color_type == PNG_COLOR_TYPE_PALETTE)
         png_set_palette_to_rgb(m_context->png_ptr);
@@ -231,7 +328,9 @@ ErrorOr<size_t> PNGLoadingContext::read_frames(png_structp png_ptr, png_infop in
         for (auto i = 0; i < frame_size.height(); ++i)
             row_pointers[i] = frame_bitmap->scanline_u8(i);
 
+        frame_being_decoded = frame_bitmap;
         png_read_image(png_ptr, row_pointers.data());
+        frame_being_decoded = nullptr;
         return frame_bitmap;
     };
 
@@ -335,6 +434,66 @@ ErrorOr<size_t> PNGLoadingContext::read_frames(png_structp png_ptr, png_infop in
     return frame_count;
 }
 
+ErrorOr<NonnullRefPtr<Bitmap>> PNGLoadingContext::read_scaled_down_frame(png_structp png_ptr, int scale_down_factor)
+{
+    VERIFY(!is_interlaced);
+
+    auto exif_orientation = exif_metadata ? static_cast<ExifOrientation>(exif_metadata->orientation().value()) : ExifOrientation::Default;
+    auto scaled_size = IntSize { ceil_div(size.width(), scale_down_factor), ceil_div(size.height(), scale_down_factor) };
+    auto bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, scaled_size, exif_orientation));
+
+    frame_being_decoded = bitmap;
+
+    Vector<u8> row;
+    TRY(row.try_resize(size.width() * 4));
+
+    // NOTE: The color channels are weighted by alpha, so that fully transparent pixels don't bleed into their neighbors.
+    Vector<u32> sums;
+    TRY(sums.try_resize(scaled_size.width() * 4));
+
+    for (int y = 0; y < size.height(); ++y) {
+        png_read_row(png_ptr, row.data(), nullptr);
+
+        for (int x = 0; x < size.width(); ++x) {
+            auto const* pixel = &row[x * 4];
+            auto* sum = &sums[(x / scale_down_factor) * 4];
+            u32 alpha = pixel[3];
+            sum[0] += pixel[0] * alpha;
+            sum[1] += pixel[1] * alpha;
+            sum[2] += pixel[2] * alpha;
+            sum[3] += alpha;
+        }
+
+        if ((y + 1) % scale_down_factor != 0 && y + 1 != size.height())
+            continue;
+
+        auto scaled_y = y / scale_down_factor;
+        auto rows_in_block = y - (scaled_y * scale_down_factor) + 1;
+        auto* scanline = bitmap->scanline_u8(scaled_y);
+
+        for (int scaled_x = 0; scaled_x < scaled_size.width(); ++scaled_x) {
+            auto* sum = &sums[scaled_x * 4];
+            auto* pixel = &scanline[scaled_x * 4];
+            auto columns_in_block = min(scale_down_factor, size.width() - (scaled_x * scale_down_factor));
+            auto alpha_sum = sum[3];
+
+            if (alpha_sum == 0) {
+                pixel[0] = pixel[1] = pixel[2] = pixel[3] = 0;
+            } else {
+                pixel[0] = sum[0] / alpha_sum;
+                pixel[1] = sum[1] / alpha_sum;
+                pixel[2] = sum[2] / alpha_sum;
+                pixel[3] = alpha_sum / (rows_in_block * columns_in_block);
+            }
+        }
+
+        sums.fill(0);
+    }
+
+    frame_being_decoded = nullptr;
+    return bitmap;
+}
+
 PNGImageDecoderPlugin::~PNGImageDecoderPlugin() = default;
 
 bool PNGImageDecoderPlugin::sniff(ReadonlyBytes data)
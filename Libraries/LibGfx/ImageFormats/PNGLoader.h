@@ -26,6 +26,7 @@ public:
     virtual size_t frame_count() override;
     virtual size_t first_animated_frame_index() override;
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame() override;
     virtual Optional<Metadata const&> metadata() override;
     virtual ErrorOr<Optional<Media::CodingIndependentCodePoints>> cicp() override;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() override;
@@ -34,6 +35,7 @@ private:
     explicit PNGImageDecoderPlugin(ReadonlyBytes);
 
     ErrorOr<void> initialize();
+    ErrorOr<void> decode_single_frame(int scale_down_factor);
 
     OwnPtr<PNGLoadingContext> m_context;
 };
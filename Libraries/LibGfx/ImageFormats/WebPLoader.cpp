@@ -34,6 +34,7 @@ struct WebPLoadingContext {
     ByteBuffer icc_data;
 
     Vector<ImageFrameDescriptor> frame_descriptors;
+    IntSize decoded_size;
 };
 
 WebPImageDecoderPlugin::WebPImageDecoderPlugin(ReadonlyBytes data, OwnPtr<WebPLoadingContext> context)
@@ -115,10 +116,13 @@ static ErrorOr<void> decode_webp_header(WebPLoadingContext& context)
     return {};
 }
 
-static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
+static ErrorOr<void> decode_webp_image(WebPLoadingContext& context, IntSize target_size)
 {
     VERIFY(context.state >= WebPLoadingContext::State::HeaderDecoded);
 
+    context.frame_descriptors.clear();
+    context.decoded_size = context.size;
+
     if (context.has_animation) {
         WebPAnimDecoderOptions anim_decoder_options {};
         WebPAnimDecoderOptionsInit(&anim_decoder_options);
@@ -150,12 +154,33 @@ static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
         }
     } else {
         auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
-        auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
+        auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, target_size));
+
+        WebPDecoderConfig config {};
+        if (!WebPInitDecoderConfig(&config))
+            return Error::from_string_literal("Failed to initialize webp decoder config");
+
+        // OPTIMIZATION: libwebp scales while decoding, so a smaller target size never needs the full resolution image in memory.
+        if (target_size != context.size) {
+            config.options.use_scaling = 1;
+            config.options.scaled_width = target_size.width();
+            config.options.scaled_height = target_size.height();
+        }
+        config.options.use_threads = 1;
 
-        auto image_data = WebPDecodeBGRAInto(context.data.data(), context.data.size(), bitmap->scanline_u8(0), bitmap->data_size(), bitmap->pitch());
-        if (image_data == nullptr)
+        config.output.colorspace = MODE_BGRA;
+        config.output.is_external_memory = 1;
+        config.output.u.RGBA.rgba = bitmap->scanline_u8(0);
+        config.output.u.RGBA.stride = bitmap->pitch();
+        config.output.u.RGBA.size = bitmap->data_size();
+
+        auto status = WebPDecode(context.data.data(), context.data.size(), &config);
+        WebPFreeDecBuffer(&config.output);
+        if (status != VP8_STATUS_OK)
             return Error::from_string_literal("Failed to decode webp image into bitmap");
 
+        context.decoded_size = target_size;
+
         auto duration = 0;
         context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
     }
@@ -204,7 +229,7 @@ size_t WebPImageDecoderPlugin::first_animated_frame_index()
     return 0;
 }
 
-ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index >= frame_count())
         return Error::from_string_literal("WebPImageDecoderPlugin: Invalid frame index");
@@ -212,8 +237,13 @@ ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == WebPLoadingContext::State::Error)
         return Error::from_string_literal("WebPImageDecoderPlugin: Decoding failed");
 
-    if (m_context->state < WebPLoadingContext::State::BitmapDecoded) {
-        TRY(decode_webp_image(*m_context));
+    // NOTE: Animations are always decoded at their natural size, since WebPAnimDecoder can't scale.
+    auto target_size = m_context->has_animation ? m_context->size : scaled_size_for_ideal_size(m_context->size, ideal_size);
+
+    // NOTE: If we already decoded at a lower resolution than what is asked for now, we have to decode again.
+    bool needs_larger_bitmap = target_size.width() > m_context->decoded_size.width() || target_size.height() > m_context->decoded_size.height();
+    if (m_context->state < WebPLoadingContext::State::BitmapDecoded || needs_larger_bitmap) {
+        TRY(decode_webp_image(*m_context, target_size));
         m_context->state = WebPLoadingContext::State::BitmapDecoded;
     }
 
@@ -34,6 +34,7 @@ ErrorOr<void> encode(Encoder& encoder, Gfx::ShareableBitmap const& shareable_bit
     TRY(encoder.encode(bitmap.size()));
     TRY(encoder.encode(static_cast<u32>(bitmap.format())));
     TRY(encoder.encode(static_cast<u32>(bitmap.alpha_type())));
+    TRY(encoder.encode(static_cast<u32>(bitmap.exif_orientation())));
     return {};
 }
 
@@ -56,8 +57,13 @@ ErrorOr<Gfx::ShareableBitmap> decode(Decoder& decoder)
         return Error::from_string_literal("IPC: Invalid Gfx::ShareableBitmap alpha type");
     auto alpha_type = static_cast<Gfx::AlphaType>(raw_alpha_type);
 
+    auto raw_exif_orientation = TRY(decoder.decode<u32>());
+    if (!Gfx::is_valid_exif_orientation(raw_exif_orientation))
+        return Error::from_string_literal("IPC: Invalid Gfx::ShareableBitmap exif orientation");
+    auto exif_orientation = static_cast<Gfx::ExifOrientation>(raw_exif_orientation);
+
     auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(anon_file.take_fd(), Gfx::Bitmap::size_in_bytes(Gfx::Bitmap::minimum_pitch(size.width(), bitmap_format), size.height())));
-    auto bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(bitmap_format, alpha_type, move(buffer), size));
+    auto bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(bitmap_format, alpha_type, move(buffer), size, exif_orientation));
 
     return Gfx::ShareableBitmap { move(bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap };
 }
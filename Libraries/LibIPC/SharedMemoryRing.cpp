@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibIPC/SharedMemoryRing.h>
+#include <sys/stat.h>
+
+namespace IPC {
+
+ErrorOr<NonnullOwnPtr<SharedMemoryRing>> SharedMemoryRing::create(size_t capacity)
+{
+    VERIFY(is_power_of_two(capacity) && capacity <= maximum_capacity);
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(size_in_bytes_for_capacity(capacity)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryRing(move(buffer), capacity));
+}
+
+ErrorOr<NonnullOwnPtr<SharedMemoryRing>> SharedMemoryRing::attach(int fd, size_t capacity)
+{
+    if (!is_power_of_two(capacity) || capacity > maximum_capacity) {
+        (void)Core::System::close(fd);
+        return Error::from_string_literal("Invalid shared memory ring capacity");
+    }
+
+    // NOTE: Touching memory beyond the end of the file would crash us, so make sure the peer gave us a large enough one.
+    auto stat = Core::System::fstat(fd);
+    if (stat.is_error() || static_cast<size_t>(stat.value().st_size) < size_in_bytes_for_capacity(capacity)) {
+        (void)Core::System::close(fd);
+        return Error::from_string_literal("Shared memory ring is too small");
+    }
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, size_in_bytes_for_capacity(capacity)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryRing(move(buffer), capacity));
+}
+
+SharedMemoryRing::SharedMemoryRing(Core::AnonymousBuffer buffer, size_t capacity)
+    : m_buffer(move(buffer))
+    , m_capacity(capacity)
+{
+}
+
+bool SharedMemoryRing::try_write(ReadonlyBytes bytes)
+{
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_acquire);
+
+    // The consumer can't have read more than we have written. If it claims otherwise, we can't use the ring anymore.
+    if (read_offset > m_write_offset || m_write_offset - read_offset > m_capacity)
+        return false;
+
+    auto free_space = m_capacity - (m_write_offset - read_offset);
+    if (bytes.size() > free_space)
+        return false;
+
+    auto offset_in_ring = m_write_offset & (m_capacity - 1);
+    auto bytes_until_end = min(bytes.size(), m_capacity - offset_in_ring);
+    memcpy(data() + offset_in_ring, bytes.data(), bytes_until_end);
+    memcpy(data(), bytes.data() + bytes_until_end, bytes.size() - bytes_until_end);
+
+    m_write_offset += bytes.size();
+    header().write_offset.store(m_write_offset, AK::MemoryOrder::memory_order_release);
+    return true;
+}
+
+ErrorOr<void> SharedMemoryRing::read(Bytes bytes)
+{
+    auto write_offset = header().write_offset.load(AK::MemoryOrder::memory_order_acquire);
+
+    if (write_offset < m_read_offset || write_offset - m_read_offset > m_capacity)
+        return Error::from_string_literal("Shared memory ring is corrupted");
+    if (bytes.size() > write_offset - m_read_offset)
+        return Error::from_string_literal("Not enough data in shared memory ring");
+
+    auto offset_in_ring = m_read_offset & (m_capacity - 1);
+    auto bytes_until_end = min(bytes.size(), m_capacity - offset_in_ring);
+    memcpy(bytes.data(), data() + offset_in_ring, bytes_until_end);
+    memcpy(bytes.data() + bytes_until_end, data(), bytes.size() - bytes_until_end);
+
+    m_read_offset += bytes.size();
+    header().read_offset.store(m_read_offset, AK::MemoryOrder::memory_order_release);
+    return {};
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// A single-producer, single-consumer ring of bytes in memory that is shared between two processes. The producer and
+// the consumer each keep their own position and only publish it to the other side, since the peer can't be trusted
+// to leave the shared memory alone.
+// NOTE: The ring only carries bytes. It is up to the user to tell the consumer how many bytes to read, and when.
+class SharedMemoryRing {
+    AK_MAKE_NONCOPYABLE(SharedMemoryRing);
+    AK_MAKE_NONMOVABLE(SharedMemoryRing);
+
+public:
+    static constexpr size_t default_capacity = 1 * MiB;
+    static constexpr size_t maximum_capacity = 64 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<SharedMemoryRing>> create(size_t capacity = default_capacity);
+    static ErrorOr<NonnullOwnPtr<SharedMemoryRing>> attach(int fd, size_t capacity);
+
+    int fd() const { return m_buffer.fd(); }
+    size_t capacity() const { return m_capacity; }
+
+    // Called by the producer. Returns false if there is not enough free space in the ring.
+    [[nodiscard]] bool try_write(ReadonlyBytes);
+
+    // Called by the consumer. Fails if fewer than bytes.size() bytes have been written to the ring.
+    ErrorOr<void> read(Bytes);
+
+private:
+    struct Header {
+        Atomic<u64> write_offset { 0 };
+        Atomic<u64> read_offset { 0 };
+    };
+
+    static size_t size_in_bytes_for_capacity(size_t capacity) { return sizeof(Header) + capacity; }
+
+    SharedMemoryRing(Core::AnonymousBuffer, size_t capacity);
+
+    Header& header() { return *reinterpret_cast<Header*>(m_buffer.data<void>()); }
+    u8* data() { return m_buffer.data<u8>() + sizeof(Header); }
+
+    Core::AnonymousBuffer m_buffer;
+    size_t m_capacity { 0 };
+
+    // Only one of these is used, depending on which side of the ring we are on.
+    u64 m_write_offset { 0 };
+    u64 m_read_offset { 0 };
+};
+
+}
@@ -158,6 +158,10 @@ struct MessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        // Hands the peer the ring that we send large payloads through. The payload is the capacity of the ring.
+        SharedMemoryRing = 2,
+        // The payload of this message is in the shared memory ring rather than in the socket.
+        PayloadInSharedMemoryRing = 3,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
@@ -175,6 +179,13 @@ struct MessageHeader {
 
 void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
 {
+    // OPTIMIZATION: Large messages are copied into shared memory once, instead of being copied into the send queue,
+    //               pushed through the kernel in small pieces, and reassembled on the other side.
+    if (m_shared_memory_for_large_messages_enabled && bytes_to_write.size() >= SHARED_MEMORY_MESSAGE_THRESHOLD) {
+        if (try_post_message_through_shared_memory(bytes_to_write, fds))
+            return;
+    }
+
     auto num_fds_to_transfer = fds.size();
 
     auto message_buffer = MessageHeader::encode_with_payload(
@@ -199,6 +210,64 @@ void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Nonn
     m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
 }
 
+bool TransportSocket::try_post_message_through_shared_memory(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
+{
+    // NOTE: The order of the payloads in the ring has to match the order of their headers in the send queue.
+    Threading::MutexLocker locker(m_outgoing_ring_mutex);
+
+    if (!m_outgoing_ring) {
+        auto ring = SharedMemoryRing::create();
+        if (ring.is_error()) {
+            dbgln("TransportSocket: Failed to create shared memory ring: {}", ring.error());
+            m_shared_memory_for_large_messages_enabled = false;
+            return false;
+        }
+
+        auto ring_fd = Core::System::dup(ring.value()->fd());
+        if (ring_fd.is_error()) {
+            dbgln("TransportSocket: Failed to duplicate shared memory ring fd: {}", ring_fd.error());
+            m_shared_memory_for_large_messages_enabled = false;
+            return false;
+        }
+
+        auto owned_ring_fd = adopt_ref(*new AutoCloseFileDescriptor(ring_fd.value()));
+        m_fds_retained_until_received_by_peer.enqueue(owned_ring_fd);
+
+        u64 capacity = ring.value()->capacity();
+        auto message_buffer = MessageHeader::encode_with_payload(
+            {
+                .type = MessageHeader::Type::SharedMemoryRing,
+                .payload_size = sizeof(capacity),
+                .fd_count = 1,
+            },
+            { &capacity, sizeof(capacity) });
+        m_send_queue->enqueue_message(move(message_buffer), { owned_ring_fd->value() });
+
+        m_outgoing_ring = ring.release_value();
+    }
+
+    // NOTE: If the peer hasn't caught up with the ring yet, the message simply goes through the socket.
+    if (!m_outgoing_ring->try_write(bytes_to_write))
+        return false;
+
+    Vector<int> raw_fds;
+    raw_fds.ensure_capacity(fds.size());
+    for (auto const& fd : fds) {
+        m_fds_retained_until_received_by_peer.enqueue(fd);
+        raw_fds.unchecked_append(fd->value());
+    }
+
+    auto message_buffer = MessageHeader::encode_with_payload(
+        {
+            .type = MessageHeader::Type::PayloadInSharedMemoryRing,
+            .payload_size = static_cast<u32>(bytes_to_write.size()),
+            .fd_count = static_cast<u32>(fds.size()),
+        },
+        {});
+    m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
+    return true;
+}
+
 ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyBytes& bytes_to_write, Vector<int>& unowned_fds)
 {
     auto num_fds_to_transfer = unowned_fds.size();
@@ -323,6 +392,53 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
         } else if (header.type == MessageHeader::Type::FileDescriptorAcknowledgement) {
             VERIFY(header.payload_size == 0);
             acknowledged_fd_count += header.fd_count;
+        } else if (header.type == MessageHeader::Type::SharedMemoryRing) {
+            if (header.payload_size + sizeof(MessageHeader) > m_unprocessed_bytes.size() - index)
+                break;
+            if (header.fd_count > m_unprocessed_fds.size())
+                break;
+            if (header.payload_size != sizeof(u64) || header.fd_count != 1) {
+                dbgln("TransportSocket: Received malformed shared memory ring header");
+                should_shutdown = true;
+                break;
+            }
+
+            u64 capacity = 0;
+            memcpy(&capacity, m_unprocessed_bytes.data() + index + sizeof(MessageHeader), sizeof(capacity));
+            received_fd_count += header.fd_count;
+
+            auto ring = SharedMemoryRing::attach(m_unprocessed_fds.dequeue().take_fd(), capacity);
+            if (ring.is_error()) {
+                dbgln("TransportSocket: Failed to attach to shared memory ring: {}", ring.error());
+                should_shutdown = true;
+                break;
+            }
+            m_incoming_ring = ring.release_value();
+        } else if (header.type == MessageHeader::Type::PayloadInSharedMemoryRing) {
+            if (header.fd_count > m_unprocessed_fds.size())
+                break;
+            if (!m_incoming_ring || header.payload_size > m_incoming_ring->capacity()) {
+                dbgln("TransportSocket: Received a message for a missing or too small shared memory ring");
+                should_shutdown = true;
+                break;
+            }
+
+            Message message;
+            message.bytes.resize(header.payload_size);
+            if (auto result = m_incoming_ring->read(message.bytes.span()); result.is_error()) {
+                dbgln("TransportSocket: Failed to read message from shared memory ring: {}", result.error());
+                should_shutdown = true;
+                break;
+            }
+
+            received_fd_count += header.fd_count;
+            for (size_t i = 0; i < header.fd_count; ++i)
+                message.fds.enqueue(m_unprocessed_fds.dequeue());
+            callback(move(message));
+
+            // NOTE: Only the header of this message is in the socket.
+            index += sizeof(MessageHeader);
+            continue;
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -11,6 +11,7 @@
 #include <AK/Queue.h>
 #include <LibCore/Socket.h>
 #include <LibIPC/File.h>
+#include <LibIPC/SharedMemoryRing.h>
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/MutexProtected.h>
 #include <LibThreading/RWLock.h>
@@ -81,6 +82,14 @@ public:
 
     void post_message(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
 
+    // Messages at least this large are sent through shared memory instead of the socket, if enabled.
+    static constexpr size_t SHARED_MEMORY_MESSAGE_THRESHOLD = 16 * KiB;
+
+    // Opts this side of the connection into sending large messages through a ring in shared memory. The socket then
+    // only carries a small header for them, along with any file descriptors.
+    // NOTE: The ring is bound to this connection, so don't use this for transports that will be transferred elsewhere.
+    void enable_shared_memory_for_large_messages() { m_shared_memory_for_large_messages_enabled = true; }
+
     enum class ShouldShutdown {
         No,
         Yes,
@@ -107,6 +116,8 @@ private:
 
     void stop_send_thread();
 
+    bool try_post_message_through_shared_memory(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
+
     NonnullOwnPtr<Core::LocalSocket> m_socket;
     mutable Threading::RWLock m_socket_rw_lock;
     ByteBuffer m_unprocessed_bytes;
@@ -119,6 +130,11 @@ private:
 
     RefPtr<Threading::Thread> m_send_thread;
     RefPtr<SendQueue> m_send_queue;
+
+    bool m_shared_memory_for_large_messages_enabled { false };
+    Threading::Mutex m_outgoing_ring_mutex;
+    OwnPtr<SharedMemoryRing> m_outgoing_ring;
+    OwnPtr<SharedMemoryRing> m_incoming_ring;
 };
 
 }
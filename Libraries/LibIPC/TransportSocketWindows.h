@@ -28,6 +28,9 @@ public:
 
     ErrorOr<void> transfer(Bytes, Vector<size_t> const& handle_offsets);
 
+    // FIXME: Send large messages through shared memory on Windows as well.
+    void enable_shared_memory_for_large_messages() { }
+
     struct [[nodiscard]] ReadResult {
         Vector<u8> bytes;
         Vector<int> fds; // always empty, present to avoid OS #ifdefs in Connection.cpp
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibImageDecoderClient/Client.h>
 
@@ -20,9 +21,10 @@ void Client::die()
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_partial_image_callbacks.clear();
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<String> cache_partition)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -45,7 +47,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
 
-    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type);
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type, move(cache_partition));
     if (!response) {
         dbgln("ImageDecoder disconnected trying to decode image");
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
@@ -57,11 +59,61 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
+ErrorOr<i64> Client::start_incremental_decode(Function<void(DecodedImage&)> on_partial_image, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<ByteString> mime_type, Optional<String> cache_partition)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::StartIncrementalDecode>(move(mime_type), move(cache_partition));
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to start an incremental decode");
+        return Error::from_string_literal("ImageDecoder disconnected");
+    }
+
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    auto image_id = response->image_id();
+    m_pending_decoded_images.set(image_id, move(promise));
+    if (on_partial_image)
+        m_partial_image_callbacks.set(image_id, move(on_partial_image));
+
+    return image_id;
+}
+
+void Client::append_to_incremental_decode(i64 image_id, ReadonlyBytes encoded_data)
+{
+    if (encoded_data.is_empty())
+        return;
+
+    auto data = ByteBuffer::copy(encoded_data);
+    if (data.is_error()) {
+        dbgln("Could not allocate encoded data: {}", data.error());
+        return;
+    }
+
+    async_append_to_incremental_decode(image_id, data.release_value());
+}
+
+void Client::finish_incremental_decode(i64 image_id)
+{
+    m_partial_image_callbacks.remove(image_id);
+    async_finish_incremental_decode(image_id);
+}
+
+void Client::cancel_incremental_decode(i64 image_id)
+{
+    m_partial_image_callbacks.remove(image_id);
+    m_pending_decoded_images.remove(image_id);
+    async_cancel_decoding(image_id);
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> bitmaps, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::IntSize natural_size, Gfx::ColorSpace color_space)
 {
-    auto bitmaps = move(bitmap_sequence.bitmaps);
     VERIFY(!bitmaps.is_empty());
 
+    m_partial_image_callbacks.remove(image_id);
+
     auto maybe_promise = m_pending_decoded_images.take(image_id);
     if (!maybe_promise.has_value()) {
         dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
@@ -73,23 +125,49 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     image.is_animated = is_animated;
     image.loop_count = loop_count;
     image.scale = scale;
+    image.natural_size = natural_size;
     image.frames.ensure_capacity(bitmaps.size());
     image.color_space = move(color_space);
     for (size_t i = 0; i < bitmaps.size(); ++i) {
-        if (!bitmaps[i]) {
+        if (!bitmaps[i].is_valid()) {
             dbgln("ImageDecoderClient: Invalid bitmap for request {} at index {}", image_id, i);
             promise->reject(Error::from_string_literal("Invalid bitmap"));
             return;
         }
 
-        image.frames.empend(bitmaps[i].release_nonnull(), durations[i]);
+        image.frames.empend(*bitmaps[i].bitmap(), durations[i]);
     }
 
     promise->resolve(move(image));
 }
 
+void Client::did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence, Gfx::ColorSpace color_space)
+{
+    // NOTE: The callback is taken out of the map while it runs, so that it may safely cancel or finish the decode.
+    auto callback = m_partial_image_callbacks.take(image_id);
+    if (!callback.has_value())
+        return;
+    ScopeGuard restore_callback = [&] {
+        if (m_pending_decoded_images.contains(image_id) && !m_partial_image_callbacks.contains(image_id))
+            m_partial_image_callbacks.set(image_id, callback.release_value());
+    };
+
+    auto& bitmaps = bitmap_sequence.bitmaps;
+    if (bitmaps.size() != 1 || !bitmaps.first())
+        return;
+
+    DecodedImage image;
+    image.natural_size = bitmaps.first()->size();
+    image.color_space = move(color_space);
+    image.frames.empend(bitmaps.first().release_nonnull(), 0u);
+
+    (*callback)(image);
+}
+
 void Client::did_fail_to_decode_image(i64 image_id, String error_message)
 {
+    m_partial_image_callbacks.remove(image_id);
+
     auto maybe_promise = m_pending_decoded_images.take(image_id);
     if (!maybe_promise.has_value()) {
         dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
@@ -23,6 +23,8 @@ struct Frame {
 struct DecodedImage {
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
+    // The size of the image itself. The frames may have been decoded at a smaller size if an ideal size was given.
+    Gfx::IntSize natural_size;
     u32 loop_count { 0 };
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
@@ -38,17 +40,28 @@ public:
 
     Client(NonnullOwnPtr<IPC::Transport>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    // If a cache partition (i.e. the top-level site the image is shown on) is given, the decoded image may be shared
+    // with other clients that ask for the same image in the same partition.
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, Optional<String> cache_partition = {});
+
+    // Decodes an image whose encoded data is still arriving. Whenever enough new data has been appended, the image is
+    // decoded as far as possible and handed to on_partial_image. Once finished, the complete image is decoded as usual.
+    ErrorOr<i64> start_incremental_decode(Function<void(DecodedImage&)> on_partial_image, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<ByteString> mime_type = {}, Optional<String> cache_partition = {});
+    void append_to_incremental_decode(i64 image_id, ReadonlyBytes);
+    void finish_incremental_decode(i64 image_id);
+    void cancel_incremental_decode(i64 image_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> bitmaps, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::IntSize natural_size, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence, Gfx::ColorSpace color_space) override;
     virtual void did_fail_to_decode_image(i64 image_id, String error_message) override;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, Function<void(DecodedImage&)>> m_partial_image_callbacks;
 };
 
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/FlyString.h>
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
@@ -35,6 +36,25 @@ struct PropertyLookupCache {
     AK::Array<Entry, max_number_of_shapes_to_remember> entries;
 };
 
+// Represents a direct-mapped cache of property lookups keyed by shape and property name, shared by all property
+// lookup sites in a VM. It catches megamorphic sites that see more shapes than a PropertyLookupCache can remember.
+struct MegamorphicPropertyLookupCache {
+    static constexpr size_t number_of_entries = 1024;
+    static_assert(is_power_of_two(number_of_entries));
+
+    struct Entry {
+        PropertyLookupCache::Entry lookup;
+        FlyString property_name;
+    };
+
+    Entry& entry_for(Shape const& shape, FlyString const& property_name)
+    {
+        return entries[pair_int_hash(ptr_hash(&shape), property_name.hash()) & (number_of_entries - 1)];
+    }
+
+    AK::Array<Entry, number_of_entries> entries;
+};
+
 struct GlobalVariableCache : public PropertyLookupCache {
     u64 environment_serial_number { 0 };
     u32 environment_binding_index { 0 };
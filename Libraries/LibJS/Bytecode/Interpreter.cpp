@@ -183,11 +183,20 @@ ALWAYS_INLINE static ThrowCompletionOr<bool> strict_equals(VM&, Value src1, Valu
 
 Interpreter::Interpreter(VM& vm)
     : m_vm(vm)
+    , m_megamorphic_property_lookup_cache(make<MegamorphicPropertyLookupCache>())
 {
 }
 
 Interpreter::~Interpreter()
 {
+    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG) {
+        auto const& statistics = m_property_lookup_cache_statistics;
+        auto total = max(statistics.inline_cache_hits + statistics.megamorphic_cache_hits + statistics.misses, 1u);
+        dbgln("Property lookup cache statistics:");
+        dbgln("     Inline cache hits: {} ({}%)", statistics.inline_cache_hits, statistics.inline_cache_hits * 100 / total);
+        dbgln("Megamorphic cache hits: {} ({}%)", statistics.megamorphic_cache_hits, statistics.megamorphic_cache_hits * 100 / total);
+        dbgln("                Misses: {} ({}%)", statistics.misses, statistics.misses * 100 / total);
+    }
 }
 
 ALWAYS_INLINE Value Interpreter::get(Operand op) const
@@ -500,6 +509,55 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             goto start;
         }
 
+        handle_GetById: {
+            auto& instruction = *reinterpret_cast<Op::GetById const*>(&bytecode[program_counter]);
+            // OPTIMIZATION: Handle a monomorphic own-property hit in the first cache slot right here,
+            //               without going through base_object_for_get() and the completion plumbing.
+            if (auto base_value = get(instruction.base()); base_value.is_object()) {
+                auto& object = base_value.as_object();
+                auto& cache_entry = executable.property_lookup_caches[instruction.cache_index()].entries[0];
+                if (!cache_entry.prototype && &object.shape() == cache_entry.shape) {
+                    auto value = object.get_direct(cache_entry.property_offset.value());
+                    if (!value.is_accessor()) {
+                        if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                            ++m_property_lookup_cache_statistics.inline_cache_hits;
+                        set(instruction.dst(), value);
+                        DISPATCH_NEXT(GetById);
+                    }
+                }
+            }
+            auto result = instruction.execute_impl(*this);
+            if (result.is_error()) [[unlikely]] {
+                if (handle_exception(program_counter, result.error_value()) == HandleExceptionResponse::ExitFromExecutable)
+                    return;
+                goto start;
+            }
+            DISPATCH_NEXT(GetById);
+        }
+
+        handle_GetGlobal: {
+            auto& instruction = *reinterpret_cast<Op::GetGlobal const*>(&bytecode[program_counter]);
+            // OPTIMIZATION: Global var bindings that hit the cached shape of the global object are read directly.
+            auto& cache = executable.global_variable_caches[instruction.cache_index()];
+            if (cache.environment_serial_number == global_declarative_environment().environment_serial_number()
+                && &global_object().shape() == cache.entries[0].shape) {
+                auto value = global_object().get_direct(cache.entries[0].property_offset.value());
+                if (!value.is_accessor()) {
+                    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                        ++m_property_lookup_cache_statistics.inline_cache_hits;
+                    set(instruction.dst(), value);
+                    DISPATCH_NEXT(GetGlobal);
+                }
+            }
+            auto result = instruction.execute_impl(*this);
+            if (result.is_error()) [[unlikely]] {
+                if (handle_exception(program_counter, result.error_value()) == HandleExceptionResponse::ExitFromExecutable)
+                    return;
+                goto start;
+            }
+            DISPATCH_NEXT(GetGlobal);
+        }
+
         handle_EnterUnwindContext: {
             auto& instruction = *reinterpret_cast<Op::EnterUnwindContext const*>(&bytecode[program_counter]);
             enter_unwind_context();
@@ -608,13 +666,11 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(Dump);
             HANDLE_INSTRUCTION(EnterObjectEnvironment);
             HANDLE_INSTRUCTION(Exp);
-            HANDLE_INSTRUCTION(GetById);
             HANDLE_INSTRUCTION(GetByIdWithThis);
             HANDLE_INSTRUCTION(GetByValue);
             HANDLE_INSTRUCTION(GetByValueWithThis);
             HANDLE_INSTRUCTION(GetCalleeAndThisFromEnvironment);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(GetCompletionFields);
-            HANDLE_INSTRUCTION(GetGlobal);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(GetImportMeta);
             HANDLE_INSTRUCTION(GetIterator);
             HANDLE_INSTRUCTION(GetLength);
@@ -1006,6 +1062,8 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
                 return true;
             }();
             if (can_use_cache) {
+                if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                    ++vm.bytecode_interpreter().property_lookup_cache_statistics().inline_cache_hits;
                 auto value = cache_entry.prototype->get_direct(cache_entry.property_offset.value());
                 if (value.is_accessor())
                     return TRY(call(vm, value.as_accessor().getter(), this_value));
@@ -1013,6 +1071,8 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
             }
         } else if (&shape == cache_entry.shape) {
             // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++vm.bytecode_interpreter().property_lookup_cache_statistics().inline_cache_hits;
             auto value = base_obj->get_direct(cache_entry.property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), this_value));
@@ -1020,8 +1080,35 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
         }
     }
 
+    auto const& property_name = executable.get_identifier(property);
+
+    // OPTIMIZATION: Sites that see more shapes than the inline cache can remember fall back to the VM-wide megamorphic cache,
+    //               which is validated the same way.
+    auto& megamorphic_entry = vm.bytecode_interpreter().megamorphic_property_lookup_cache().entry_for(shape, property_name);
+    if (&shape == megamorphic_entry.lookup.shape && megamorphic_entry.property_name == property_name) {
+        auto const& cache_entry = megamorphic_entry.lookup;
+        Object const* holder = base_obj;
+        if (cache_entry.prototype) {
+            if (cache_entry.prototype_chain_validity && cache_entry.prototype_chain_validity->is_valid())
+                holder = cache_entry.prototype.ptr();
+            else
+                holder = nullptr;
+        }
+        if (holder) {
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++vm.bytecode_interpreter().property_lookup_cache_statistics().megamorphic_cache_hits;
+            auto value = holder->get_direct(cache_entry.property_offset.value());
+            if (value.is_accessor())
+                return TRY(call(vm, value.as_accessor().getter(), this_value));
+            return value;
+        }
+    }
+
+    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+        ++vm.bytecode_interpreter().property_lookup_cache_statistics().misses;
+
     CacheablePropertyMetadata cacheable_metadata;
-    auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
+    auto value = TRY(base_obj->internal_get(property_name, this_value, &cacheable_metadata));
 
     // If internal_get() caused object's shape change, we can no longer be sure
     // that collected metadata is valid, e.g. if getter in prototype chain added
@@ -1038,12 +1125,14 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
             auto& entry = get_cache_slot();
             entry.shape = shape;
             entry.property_offset = cacheable_metadata.property_offset.value();
+            megamorphic_entry = { entry, property_name };
         } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
             auto& entry = get_cache_slot();
             entry.shape = &base_obj->shape();
             entry.property_offset = cacheable_metadata.property_offset.value();
             entry.prototype = *cacheable_metadata.prototype;
             entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+            megamorphic_entry = { entry, property_name };
         }
     }
 
@@ -1143,6 +1232,8 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         // OPTIMIZATION: For global var bindings, if the shape of the global object hasn't changed,
         //               we can use the cached property offset.
         if (&shape == cache.entries[0].shape) {
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++interpreter.property_lookup_cache_statistics().inline_cache_hits;
             auto value = binding_object.get_direct(cache.entries[0].property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), js_undefined()));
@@ -1152,6 +1243,8 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         // OPTIMIZATION: For global lexical bindings, if the global declarative environment hasn't changed,
         //               we can use the cached environment binding index.
         if (cache.has_environment_binding_index) {
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++interpreter.property_lookup_cache_statistics().inline_cache_hits;
             if (cache.in_module_environment) {
                 auto module = vm.running_execution_context().script_or_module.get_pointer<GC::Ref<Module>>();
                 return (*module)->environment()->get_binding_value_direct(vm, cache.environment_binding_index);
@@ -1160,6 +1253,9 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         }
     }
 
+    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+        ++interpreter.property_lookup_cache_statistics().misses;
+
     cache.environment_serial_number = declarative_record.environment_serial_number();
 
     auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
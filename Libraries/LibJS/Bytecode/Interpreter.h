@@ -84,6 +84,16 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    MegamorphicPropertyLookupCache& megamorphic_property_lookup_cache() { return *m_megamorphic_property_lookup_cache; }
+
+    // Only maintained when JS_PROPERTY_LOOKUP_CACHE_DEBUG is enabled.
+    struct PropertyLookupCacheStatistics {
+        u64 inline_cache_hits { 0 };
+        u64 megamorphic_cache_hits { 0 };
+        u64 misses { 0 };
+    };
+    PropertyLookupCacheStatistics& property_lookup_cache_statistics() { return m_property_lookup_cache_statistics; }
+
 private:
     void run_bytecode(size_t entry_point);
 
@@ -102,6 +112,8 @@ private:
     Span<Value> m_registers_and_constants_and_locals_arguments;
     Vector<Value> m_argument_values_buffer;
     ExecutionContext* m_running_execution_context { nullptr };
+    NonnullOwnPtr<MegamorphicPropertyLookupCache> m_megamorphic_property_lookup_cache;
+    PropertyLookupCacheStatistics m_property_lookup_cache_statistics;
 };
 
 JS_API extern bool g_dump_bytecode;
@@ -256,6 +256,7 @@ private:
     void load_state();
     void discard_saved_state();
     Position position() const;
+    String source_text_for_range(size_t start_offset, size_t end_offset) const;
 
     RefPtr<BindingPattern const> synthesize_binding_pattern(Expression const& expression);
 
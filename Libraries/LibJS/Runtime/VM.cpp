@@ -68,6 +68,7 @@ VM::VM(ErrorMessages error_messages)
         gather_roots(roots);
     })
     , m_error_messages(move(error_messages))
+    , m_script_parse_cache(adopt_ref(*new ScriptParseCache))
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
@@ -202,7 +203,12 @@ VM::VM(ErrorMessages error_messages)
     };
 }
 
-VM::~VM() = default;
+VM::~VM()
+{
+    // NOTE: A pending eviction task keeps the cache itself alive until the heap runs it, but the parse trees (and the
+    //       roots they hold) must go away while the heap is still intact.
+    purge_script_parse_cache();
+}
 
 String const& VM::error_message(ErrorMessage type) const
 {
@@ -511,6 +517,74 @@ ScriptOrModule VM::get_active_script_or_module() const
     return m_execution_context_stack[0]->script_or_module;
 }
 
+RefPtr<Program> VM::cached_script_parse_node(String const& partition, StringView source_text, StringView filename, size_t line_number_offset)
+{
+    auto source_hash = source_text.hash();
+    auto& entries = m_script_parse_cache->entries;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        auto& entry = entries[i];
+        if (entry.source_hash != source_hash || entry.line_number_offset != line_number_offset || entry.partition != partition)
+            continue;
+        auto const& source_code = entry.parse_node->source_code();
+        if (source_code.code() != source_text || source_code.filename() != filename)
+            continue;
+        entry.last_used_in_collection = m_heap.collection_count();
+        auto parse_node = entry.parse_node;
+        entries.append(entries.take(i));
+        return parse_node;
+    }
+    return nullptr;
+}
+
+void VM::cache_script_parse_node(String partition, NonnullRefPtr<Program> parse_node, size_t line_number_offset)
+{
+    auto& cache = *m_script_parse_cache;
+    auto const& source_text = parse_node->source_code().code();
+    if (source_text.bytes().size() > ScriptParseCache::source_size_limit)
+        return;
+
+    cache.source_size += source_text.bytes().size();
+    cache.entries.append({ move(partition), source_text.bytes_as_string_view().hash(), line_number_offset, m_heap.collection_count(), move(parse_node) });
+
+    while (cache.source_size > ScriptParseCache::source_size_limit)
+        cache.remove_entry(0);
+
+    cache.schedule_eviction_of_unused_entries(m_heap);
+}
+
+void VM::purge_script_parse_cache()
+{
+    m_script_parse_cache->entries.clear();
+    m_script_parse_cache->source_size = 0;
+}
+
+void VM::ScriptParseCache::remove_entry(size_t index)
+{
+    auto entry = entries.take(index);
+    source_size -= entry.parse_node->source_code().code().bytes().size();
+}
+
+void VM::ScriptParseCache::schedule_eviction_of_unused_entries(GC::Heap& heap)
+{
+    if (eviction_is_scheduled || entries.is_empty())
+        return;
+    eviction_is_scheduled = true;
+
+    // NOTE: Garbage collections are driven by allocation volume, so they double as our memory pressure signal: parse
+    //       trees that haven't been reused for a few of them are not worth the memory (and executables) they keep alive.
+    heap.enqueue_post_gc_task([&heap, cache = NonnullRefPtr { *this }] {
+        cache->eviction_is_scheduled = false;
+        auto collection_count = heap.collection_count();
+        for (size_t i = 0; i < cache->entries.size();) {
+            if (collection_count - cache->entries[i].last_used_in_collection > max_unused_collections)
+                cache->remove_entry(i);
+            else
+                ++i;
+        }
+        cache->schedule_eviction_of_unused_entries(heap);
+    });
+}
+
 VM::StoredModule* VM::get_stored_module(ImportedModuleReferrer const&, ByteString const& filename, String const&)
 {
     // Note the spec says:
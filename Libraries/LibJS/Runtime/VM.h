@@ -59,6 +59,10 @@ public:
 
     void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&);
 
+    RefPtr<Program> cached_script_parse_node(String const& partition, StringView source_text, StringView filename, size_t line_number_offset);
+    void cache_script_parse_node(String partition, NonnullRefPtr<Program>, size_t line_number_offset);
+    void purge_script_parse_cache();
+
 #define __JS_ENUMERATE(SymbolName, snake_name)             \
     GC::Ref<Symbol> well_known_symbol_##snake_name() const \
     {                                                      \
@@ -291,6 +295,10 @@ public:
     Function<ThrowCompletionOr<void>(Realm&, NonnullOwnPtr<ExecutionContext>, ShadowRealm&)> host_initialize_shadow_realm;
     Function<Crypto::SignedBigInteger(Object const& global)> host_system_utc_epoch_nanoseconds;
 
+    // Returns the key that scripts parsed in the given realm may share parse trees (and the bytecode generated for them)
+    // under, or nothing if they may not be shared at all. Without this hook, parse trees are never reused.
+    Function<Optional<String>(Realm&)> host_get_script_parse_cache_partition;
+
     Vector<StackTraceElement> stack_trace() const;
 
 private:
@@ -355,6 +363,30 @@ private:
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
     bool m_dynamic_imports_allowed { false };
+
+    // Parse trees of recently parsed scripts, most recently used last. Scripts with identical source text in the same
+    // partition (such as the same bundle being loaded again after a navigation) reuse these, and with them the bytecode
+    // already generated for their functions. Entries that go unused for a few garbage collections are dropped again.
+    struct ScriptParseCache : public RefCounted<ScriptParseCache> {
+        struct Entry {
+            String partition;
+            u32 source_hash { 0 };
+            size_t line_number_offset { 0 };
+            size_t last_used_in_collection { 0 };
+            NonnullRefPtr<Program> parse_node;
+        };
+
+        void remove_entry(size_t index);
+        void schedule_eviction_of_unused_entries(GC::Heap&);
+
+        static constexpr size_t source_size_limit = 16 * MiB;
+        static constexpr size_t max_unused_collections = 4;
+
+        Vector<Entry> entries;
+        size_t source_size { 0 };
+        bool eviction_is_scheduled { false };
+    };
+    NonnullRefPtr<ScriptParseCache> m_script_parse_cache;
 };
 
 template<typename GlobalObjectType, typename... Args>
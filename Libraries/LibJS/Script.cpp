@@ -17,6 +17,20 @@ GC_DEFINE_ALLOCATOR(Script);
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
 Result<GC::Ref<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
+    auto& vm = realm.vm();
+
+    // OPTIMIZATION: Parsing is deterministic, so a script with the same source text as one we've parsed before
+    //               can reuse its parse tree (and any bytecode generated for it) instead of being parsed again.
+    //               This is only done within the partition the host puts the realm in, since the bytecode and
+    //               its inline caches are shared along with the tree.
+    Optional<String> cache_partition;
+    if (vm.host_get_script_parse_cache_partition)
+        cache_partition = vm.host_get_script_parse_cache_partition(realm);
+    if (cache_partition.has_value()) {
+        if (auto cached_script = vm.cached_script_parse_node(*cache_partition, source_text, filename, line_number_offset))
+            return realm.heap().allocate<Script>(realm, filename, cached_script.release_nonnull(), host_defined);
+    }
+
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
     auto script = parser.parse_program();
@@ -25,6 +39,9 @@ Result<GC::Ref<Script>, Vector<ParserError>> Script::parse(StringView source_tex
     if (parser.has_errors())
         return parser.errors();
 
+    if (cache_partition.has_value())
+        vm.cache_script_parse_node(cache_partition.release_value(), script, line_number_offset);
+
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
     return realm.heap().allocate<Script>(realm, filename, move(script), host_defined);
 }
@@ -55,11 +55,22 @@ void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_
         m_internal_buffered_data->response_headers = headers;
         m_internal_buffered_data->response_code = move(response_code);
         m_internal_buffered_data->reason_phrase = reason_phrase;
+
+        // OPTIMIZATION: Size the payload buffer up front, so that large responses don't have to be reallocated (and
+        //               copied) over and over as they come in.
+        // NOTE: The Content-Length is only a hint, as the response may have been decoded since. It also comes from
+        //       the server, so we don't let it reserve an unreasonable amount of memory.
+        static constexpr size_t maximum_payload_size_to_reserve = 64 * MiB;
+        if (auto content_length_header = headers.get("Content-Length"sv); content_length_header.has_value()) {
+            if (auto content_length = content_length_header->to_number<u64>(); content_length.has_value())
+                (void)m_internal_buffered_data->payload.try_ensure_capacity(min<u64>(*content_length, maximum_payload_size_to_reserve));
+        }
     };
 
     on_finish = [this, on_buffered_request_finished = move(on_buffered_request_finished)](auto total_size, auto& timing_info, auto network_error) {
-        auto output_buffer = ByteBuffer::create_uninitialized(m_internal_buffered_data->payload_stream.used_buffer_size()).release_value_but_fixme_should_propagate_errors();
-        m_internal_buffered_data->payload_stream.read_until_filled(output_buffer).release_value_but_fixme_should_propagate_errors();
+        // NOTE: The payload is handed off to the callback, rather than copied. It's the only copy of the response we
+        //       hold on to, and it could be large.
+        auto payload = move(m_internal_buffered_data->payload);
 
         on_buffered_request_finished(
             total_size,
@@ -68,12 +79,12 @@ void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_
             m_internal_buffered_data->response_headers,
             m_internal_buffered_data->response_code,
             m_internal_buffered_data->reason_phrase,
-            output_buffer);
+            move(payload));
     };
 
     set_up_internal_stream_data([this](auto read_bytes) {
         // FIXME: What do we do if this fails?
-        m_internal_buffered_data->payload_stream.write_until_depleted(read_bytes).release_value_but_fixme_should_propagate_errors();
+        m_internal_buffered_data->payload.try_append(read_bytes).release_value_but_fixme_should_propagate_errors();
     });
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/Function.h>
 #include <AK/MemoryStream.h>
@@ -37,10 +38,11 @@ public:
     int fd() const { return m_fd; }
     bool stop();
 
-    using BufferedRequestFinished = Function<void(u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error, HTTP::HeaderMap const& response_headers, Optional<u32> response_code, Optional<String> reason_phrase, ReadonlyBytes payload)>;
+    using BufferedRequestFinished = Function<void(u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error, HTTP::HeaderMap const& response_headers, Optional<u32> response_code, Optional<String> reason_phrase, ByteBuffer payload)>;
 
     // Configure the request such that the entirety of the response data is buffered. The callback receives that data and
-    // the response headers all at once. Using this method is mutually exclusive with `set_unbuffered_data_received_callback`.
+    // the response headers all at once, and takes ownership of the data. Using this method is mutually exclusive with
+    // `set_unbuffered_data_received_callback`.
     void set_buffered_request_finished_callback(BufferedRequestFinished);
 
     using HeadersReceived = Function<void(HTTP::HeaderMap const& response_headers, Optional<u32> response_code, Optional<String> const& reason_phrase)>;
@@ -81,7 +83,7 @@ private:
     RequestFinished on_finish;
 
     struct InternalBufferedData {
-        AllocatingMemoryStream payload_stream;
+        ByteBuffer payload;
         HTTP::HeaderMap response_headers;
         Optional<u32> response_code;
         Optional<String> reason_phrase;
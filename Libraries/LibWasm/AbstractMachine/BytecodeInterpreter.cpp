@@ -10,6 +10,7 @@
 #include <AK/Endian.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/ScopeGuard.h>
 #include <AK/SIMDExtras.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
@@ -33,23 +34,38 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+    if (configuration.should_limit_instruction_count())
+        interpret_impl<true>(configuration);
+    else
+        interpret_impl<false>(configuration);
+}
+
+// OPTIMIZATION: The instruction count limit is decided once per call rather than once per instruction,
+//               so the common unlimited case runs a dispatch loop with no extra compare-and-branch.
+template<bool HaveInstructionCountLimit>
+void BytecodeInterpreter::interpret_impl(Configuration& configuration)
+{
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
-    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
     u64 executed_instructions = 0;
 
+    ScopeGuard update_executed_instruction_count = [&] {
+        m_executed_instructions += executed_instructions;
+    };
+
     while (current_ip_value < max_ip_value) {
-        if (should_limit_instruction_count) {
-            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
+        if constexpr (HaveInstructionCountLimit) {
+            if (executed_instructions >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
                 m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");
                 return;
             }
         }
+        ++executed_instructions;
         auto& instruction = instructions[current_ip_value.value()];
         auto old_ip = current_ip_value;
         interpret_instruction(configuration, current_ip_value, instruction);
-        if (did_trap())
+        if (did_trap()) [[unlikely]]
             return;
         if (current_ip_value == old_ip) // If no jump occurred
             ++current_ip_value;
@@ -59,9 +75,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    for (size_t i = 0; i < index.value(); ++i)
-        configuration.label_stack().take_last();
-    auto label = configuration.label_stack().last();
+    auto& label_stack = configuration.label_stack();
+    label_stack.shrink(label_stack.size() - index.value(), true);
+    auto label = label_stack.last();
     dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
 
     configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
@@ -27,6 +27,9 @@ struct BytecodeInterpreter : public Interpreter {
         return m_trap.get<Trap>();
     }
     virtual void clear_trap() final { m_trap = Empty {}; }
+
+    // Total number of instructions executed by this interpreter, including nested calls.
+    u64 executed_instructions() const { return m_executed_instructions; }
     virtual void visit_external_resources(HostVisitOps const& host) override
     {
         if (auto ptr = m_trap.get_pointer<Trap>())
@@ -53,6 +56,8 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    template<bool HaveInstructionCountLimit>
+    void interpret_impl(Configuration&);
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -104,6 +109,7 @@ protected:
 
     Variant<Trap, Empty> m_trap;
     StackInfo const& m_stack_info;
+    u64 m_executed_instructions { 0 };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
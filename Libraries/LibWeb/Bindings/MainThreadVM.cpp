@@ -660,6 +660,15 @@ void initialize_main_thread_vm(AgentType type)
     s_main_thread_vm->host_unrecognized_date_string = [](StringView date) {
         dbgln("Unable to parse date string: \"{}\"", date);
     };
+
+    // NOTE: Parse trees are only shared between scripts of the same origin, so that no bytecode or inline caches
+    //       filled by one site are ever used by another.
+    s_main_thread_vm->host_get_script_parse_cache_partition = [](JS::Realm& realm) -> Optional<String> {
+        auto const& origin = HTML::principal_realm_settings_object(realm).origin();
+        if (origin.is_opaque())
+            return {};
+        return origin.serialize();
+    };
 }
 
 JS::VM& main_thread_vm()
@@ -71,6 +71,13 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
     }
     invalidation.repaint = true;
 
+    // NOTE: These properties change how the whole subtree is painted, and descendants may paint outside of the
+    //       element's own rect. Gradient stops are painted by whichever element uses the gradient.
+    if (CSS::property_affects_stacking_context(property_id)
+        || AK::first_is_one_of(property_id, CSS::PropertyID::Filter, CSS::PropertyID::MixBlendMode, CSS::PropertyID::Isolation, CSS::PropertyID::Mask, CSS::PropertyID::MaskType, CSS::PropertyID::Clip, CSS::PropertyID::TransformOrigin, CSS::PropertyID::TransformBox, CSS::PropertyID::StopColor, CSS::PropertyID::StopOpacity)) {
+        invalidation.repaint_whole_viewport = true;
+    }
+
     return invalidation;
 }
 
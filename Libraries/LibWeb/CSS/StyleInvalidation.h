@@ -15,6 +15,9 @@ struct RequiredInvalidationAfterStyleChange {
     bool rebuild_stacking_context_tree : 1 { false };
     bool relayout : 1 { false };
     bool rebuild_layout_tree : 1 { false };
+    // The change may affect pixels outside of the element's own paintable (e.g. those of its descendants), so the
+    // whole viewport has to be repainted.
+    bool repaint_whole_viewport : 1 { false };
 
     void operator|=(RequiredInvalidationAfterStyleChange const& other)
     {
@@ -22,11 +25,12 @@ struct RequiredInvalidationAfterStyleChange {
         rebuild_stacking_context_tree |= other.rebuild_stacking_context_tree;
         relayout |= other.relayout;
         rebuild_layout_tree |= other.rebuild_layout_tree;
+        repaint_whole_viewport |= other.repaint_whole_viewport;
     }
 
-    [[nodiscard]] bool is_none() const { return !repaint && !rebuild_stacking_context_tree && !relayout && !rebuild_layout_tree; }
-    [[nodiscard]] bool is_full() const { return repaint && rebuild_stacking_context_tree && relayout && rebuild_layout_tree; }
-    static RequiredInvalidationAfterStyleChange full() { return { true, true, true, true }; }
+    [[nodiscard]] bool is_none() const { return !repaint && !rebuild_stacking_context_tree && !relayout && !rebuild_layout_tree && !repaint_whole_viewport; }
+    [[nodiscard]] bool is_full() const { return repaint && rebuild_stacking_context_tree && relayout && rebuild_layout_tree && repaint_whole_viewport; }
+    static RequiredInvalidationAfterStyleChange full() { return { true, true, true, true, true }; }
 };
 
 RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::PropertyID property_id, RefPtr<CSSStyleValue const> const& old_value, RefPtr<CSSStyleValue const> const& new_value);
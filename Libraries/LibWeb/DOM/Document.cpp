@@ -569,6 +569,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_resize_observers);
 
     visitor.visit(m_shared_resource_requests);
+    visitor.visit(m_map_of_preloaded_resources);
 
     visitor.visit(m_associated_animation_timelines);
     visitor.visit(m_list_of_available_images);
@@ -603,6 +604,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_session_storage_holder);
     visitor.visit(m_render_blocking_elements);
     visitor.visit(m_policy_container);
+    visitor.visit(m_paintables_needing_display_after_resolving_paint_only_properties);
 }
 
 // https://w3c.github.io/selection-api/#dom-document-getselection
@@ -1291,6 +1293,111 @@ static void propagate_overflow_to_viewport(Element& root_element, Layout::Viewpo
     overflow_origin_computed_values.set_overflow_y(CSS::Overflow::Visible);
 }
 
+static void prepare_subtree_for_layout(Layout::Box& root)
+{
+    root.for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
+        if (child.needs_layout_update()) {
+            child.reset_cached_intrinsic_sizes();
+        }
+        child.clear_contained_abspos_children();
+        return TraversalDecision::Continue;
+    });
+
+    // Assign each box that establishes a formatting context a list of absolutely positioned children it should take care of during layout
+    root.for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
+        if (!child.is_absolutely_positioned())
+            return TraversalDecision::Continue;
+        if (auto containing_block = child.containing_block()) {
+            auto closest_box_that_establishes_formatting_context = containing_block;
+            while (closest_box_that_establishes_formatting_context) {
+                if (closest_box_that_establishes_formatting_context == &root)
+                    break;
+                if (Layout::FormattingContext::formatting_context_type_created_by_box(*closest_box_that_establishes_formatting_context).has_value()) {
+                    break;
+                }
+                closest_box_that_establishes_formatting_context = closest_box_that_establishes_formatting_context->containing_block();
+            }
+            VERIFY(closest_box_that_establishes_formatting_context);
+            closest_box_that_establishes_formatting_context->add_contained_abspos_child(child);
+        }
+        return TraversalDecision::Continue;
+    });
+}
+
+// Returns false if something that needs a layout update is not inside of a layout boundary.
+static bool collect_layout_boundaries_needing_layout_update(Layout::Node& node, Vector<GC::Ref<Layout::Box>>& layout_boundaries)
+{
+    if (node.needs_layout_update_of_self())
+        return false;
+
+    bool is_inside_layout_boundaries = true;
+    node.for_each_child([&](Layout::Node& child) {
+        if (!child.needs_layout_update())
+            return IterationDecision::Continue;
+
+        if (!child.needs_layout_update_of_self() && child.is_box() && static_cast<Layout::Box&>(child).is_layout_boundary()) {
+            layout_boundaries.append(static_cast<Layout::Box&>(child));
+            return IterationDecision::Continue;
+        }
+
+        if (!collect_layout_boundaries_needing_layout_update(child, layout_boundaries)) {
+            is_inside_layout_boundaries = false;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return is_inside_layout_boundaries;
+}
+
+static void lay_out_layout_boundary(Layout::Box& layout_boundary)
+{
+    prepare_subtree_for_layout(layout_boundary);
+
+    Layout::LayoutState layout_state;
+
+    {
+        auto& block_container = as<Layout::BlockContainer>(layout_boundary);
+        Layout::BlockFormattingContext formatting_context(layout_state, Layout::LayoutMode::Normal, block_container, nullptr);
+
+        // NOTE: The size and position of a layout boundary don't depend on anything inside of it, so we can take them
+        //       from the previous layout.
+        auto const& paintable_box = *layout_boundary.paintable_box();
+        auto const& box_model = paintable_box.box_model();
+        auto& state = layout_state.get_mutable(block_container);
+        state.inset_top = box_model.inset.top;
+        state.inset_right = box_model.inset.right;
+        state.inset_bottom = box_model.inset.bottom;
+        state.inset_left = box_model.inset.left;
+        state.padding_top = box_model.padding.top;
+        state.padding_right = box_model.padding.right;
+        state.padding_bottom = box_model.padding.bottom;
+        state.padding_left = box_model.padding.left;
+        state.border_top = box_model.border.top;
+        state.border_right = box_model.border.right;
+        state.border_bottom = box_model.border.bottom;
+        state.border_left = box_model.border.left;
+        state.margin_top = box_model.margin.top;
+        state.margin_right = box_model.margin.right;
+        state.margin_bottom = box_model.margin.bottom;
+        state.margin_left = box_model.margin.left;
+        state.set_content_width(paintable_box.content_width());
+        state.set_content_height(paintable_box.content_height());
+
+        // NOTE: The offset of the paintable includes the relative position inset, which LayoutState::commit() applies again.
+        auto offset = paintable_box.offset();
+        if (layout_boundary.computed_values().position() == CSS::Positioning::Relative)
+            offset.translate_by(-box_model.inset.left, -box_model.inset.top);
+        state.set_content_offset(offset);
+
+        formatting_context.run(
+            Layout::AvailableSpace(
+                Layout::AvailableSize::make_definite(paintable_box.content_width()),
+                Layout::AvailableSize::make_definite(paintable_box.content_height())));
+    }
+
+    layout_state.commit(layout_boundary);
+}
+
 void Document::update_layout(UpdateLayoutReason reason)
 {
     auto navigable = this->navigable();
@@ -1317,14 +1424,23 @@ void Document::update_layout(UpdateLayoutReason reason)
 
     invalidate_display_list();
 
+    // NOTE: The layout damages the whole viewport, and replaces the paintables anyway.
+    m_paintables_needing_display_after_resolving_paint_only_properties.clear();
+
     auto* document_element = this->document_element();
     auto viewport_rect = navigable->viewport_rect();
 
     auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
+    // NOTE: TreeBuilder only builds the subtrees of DOM nodes that need a layout tree update again, unless it has to
+    //       create a whole new layout tree.
+    bool did_create_new_layout_tree = false;
     if (!m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update()) {
+        auto old_layout_root = m_layout_root;
         Layout::TreeBuilder tree_builder;
         m_layout_root = as<Layout::Viewport>(*tree_builder.build(*this));
+        did_create_new_layout_tree = m_layout_root != old_layout_root;
+        invalidate_layout_subtree_caches();
 
         if (document_element && document_element->layout_node()) {
             propagate_overflow_to_viewport(*document_element, *m_layout_root);
@@ -1343,57 +1459,46 @@ void Document::update_layout(UpdateLayoutReason reason)
         return TraversalDecision::Continue;
     });
 
-    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
-        if (child.needs_layout_update()) {
-            child.reset_cached_intrinsic_sizes();
-        }
-        child.clear_contained_abspos_children();
-        return TraversalDecision::Continue;
-    });
+    // OPTIMIZATION: If everything that needs a layout update is inside of layout boundaries, we only lay out those
+    //               boundaries again, instead of the whole document.
+    Vector<GC::Ref<Layout::Box>> layout_boundaries;
+    if (!did_create_new_layout_tree && collect_layout_boundaries_needing_layout_update(*m_layout_root, layout_boundaries) && !layout_boundaries.is_empty()) {
+        for (auto& layout_boundary : layout_boundaries)
+            lay_out_layout_boundary(layout_boundary);
 
-    // Assign each box that establishes a formatting context a list of absolutely positioned children it should take care of during layout
-    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
-        if (!child.is_absolutely_positioned())
-            return TraversalDecision::Continue;
-        if (auto containing_block = child.containing_block()) {
-            auto closest_box_that_establishes_formatting_context = containing_block;
-            while (closest_box_that_establishes_formatting_context) {
-                if (closest_box_that_establishes_formatting_context == m_layout_root)
-                    break;
-                if (Layout::FormattingContext::formatting_context_type_created_by_box(*closest_box_that_establishes_formatting_context).has_value()) {
-                    break;
-                }
-                closest_box_that_establishes_formatting_context = closest_box_that_establishes_formatting_context->containing_block();
-            }
-            VERIFY(closest_box_that_establishes_formatting_context);
-            closest_box_that_establishes_formatting_context->add_contained_abspos_child(child);
+        // NOTE: The stacking contexts still refer to the paintables we just replaced.
+        invalidate_stacking_context_tree();
+
+        if constexpr (UPDATE_LAYOUT_DEBUG) {
+            dbgln("PARTIAL LAYOUT of {} layout boundaries", layout_boundaries.size());
         }
-        return TraversalDecision::Continue;
-    });
+    } else {
+        prepare_subtree_for_layout(*m_layout_root);
 
-    Layout::LayoutState layout_state;
+        Layout::LayoutState layout_state;
 
-    {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
+        {
+            Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
-        auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
-        auto& viewport_state = layout_state.get_mutable(viewport);
-        viewport_state.set_content_width(viewport_rect.width());
-        viewport_state.set_content_height(viewport_rect.height());
+            auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
+            auto& viewport_state = layout_state.get_mutable(viewport);
+            viewport_state.set_content_width(viewport_rect.width());
+            viewport_state.set_content_height(viewport_rect.height());
 
-        if (document_element && document_element->layout_node()) {
-            auto& icb_state = layout_state.get_mutable(as<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
-            icb_state.set_content_width(viewport_rect.width());
+            if (document_element && document_element->layout_node()) {
+                auto& icb_state = layout_state.get_mutable(as<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
+                icb_state.set_content_width(viewport_rect.width());
+            }
+
+            root_formatting_context.run(
+                Layout::AvailableSpace(
+                    Layout::AvailableSize::make_definite(viewport_rect.width()),
+                    Layout::AvailableSize::make_definite(viewport_rect.height())));
         }
 
-        root_formatting_context.run(
-            Layout::AvailableSpace(
-                Layout::AvailableSize::make_definite(viewport_rect.width()),
-                Layout::AvailableSize::make_definite(viewport_rect.height())));
+        layout_state.commit(*m_layout_root);
     }
 
-    layout_state.commit(*m_layout_root);
-
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
@@ -1415,6 +1520,9 @@ void Document::update_layout(UpdateLayoutReason reason)
     }
 
     m_layout_root->for_each_in_inclusive_subtree([](auto& node) {
+        // NOTE: Nodes that don't need a layout update can't have descendants that do.
+        if (!node.needs_layout_update())
+            return TraversalDecision::SkipChildrenAndContinue;
         node.reset_needs_layout_update();
         return TraversalDecision::Continue;
     });
@@ -1554,8 +1662,11 @@ void Document::update_style()
     style_computer().reset_ancestor_filter();
 
     auto invalidation = update_style_recursively(*this, style_computer(), false);
-    if (!invalidation.is_none())
+    // NOTE: Elements whose style only needs a repaint have damaged the rects of their paintables already.
+    if (invalidation.relayout || invalidation.rebuild_layout_tree || invalidation.rebuild_stacking_context_tree || invalidation.repaint_whole_viewport)
         invalidate_display_list();
+    else if (invalidation.repaint)
+        clear_cached_display_list();
     if (invalidation.rebuild_stacking_context_tree)
         invalidate_stacking_context_tree();
     m_needs_full_style_update = false;
@@ -1590,6 +1701,10 @@ void Document::update_paint_and_hit_testing_properties_if_needed()
     if (auto* paintable = this->paintable()) {
         paintable->resolve_paint_only_properties();
     }
+
+    for (auto& paintable : m_paintables_needing_display_after_resolving_paint_only_properties)
+        paintable->set_needs_display(InvalidateDisplayList::No);
+    m_paintables_needing_display_after_resolving_paint_only_properties.clear();
 }
 
 void Document::set_normal_link_color(Color color)
@@ -3099,6 +3214,10 @@ void Document::completely_finish_loading()
     // 2. Set document's completely loaded time to the current time.
     m_completely_loaded_time = AK::UnixDateTime::now();
 
+    // NOTE: The parser is done with this document, so whatever the preload scanner fetched that has not been consumed by
+    //       now never will be. Drop those entries instead of keeping their response bodies alive along with the document.
+    m_map_of_preloaded_resources.clear();
+
     // NOTE: See the end of shared_declarative_refresh_steps.
     if (m_active_refresh_timer)
         m_active_refresh_timer->start();
@@ -6356,31 +6475,45 @@ void Document::set_needs_display(InvalidateDisplayList should_invalidate_display
     set_needs_display(viewport_rect(), should_invalidate_display_list);
 }
 
-void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList should_invalidate_display_list)
+void Document::set_needs_display(CSSPixelRect const& rect, InvalidateDisplayList should_invalidate_display_list)
 {
-    // FIXME: Ignore updates outside the visible viewport rect.
-    //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
-
-    if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
-        invalidate_display_list();
-    }
+    // NOTE: We don't mark the whole viewport as damaged here, since the caller told us which part of it changed.
+    if (should_invalidate_display_list == InvalidateDisplayList::Yes)
+        clear_cached_display_list();
 
     auto navigable = this->navigable();
     if (!navigable)
         return;
 
     if (navigable->is_traversable()) {
-        navigable->traversable_navigable()->set_needs_repaint();
+        // NOTE: The rect is in document coordinates, but the backing store only contains what's inside the viewport.
+        auto viewport_rect = this->viewport_rect();
+        auto damaged_rect = rect.intersected(viewport_rect).translated(-viewport_rect.location());
+        if (!damaged_rect.is_empty()) {
+            // NOTE: Inflate the rect a little to account for anti-aliased edges that bleed into neighboring device pixels.
+            auto damaged_device_rect = page().enclosing_device_rect(damaged_rect).to_type<int>().inflated(2, 2);
+            navigable->traversable_navigable()->set_needs_repaint(damaged_device_rect.to_type<DevicePixels>());
+        }
         Web::HTML::main_thread_event_loop().schedule();
         return;
     }
 
+    // FIXME: Map the rect into the coordinate space of the container document instead of repainting all of it.
     if (auto container = navigable->container()) {
         container->document().set_needs_display(should_invalidate_display_list);
     }
 }
 
 void Document::invalidate_display_list()
+{
+    clear_cached_display_list();
+
+    // NOTE: Without a rect, we don't know what changed, so the next frame has to repaint everything.
+    if (auto navigable = this->navigable(); navigable && navigable->traversable_navigable())
+        navigable->traversable_navigable()->mark_whole_viewport_as_damaged();
+}
+
+void Document::clear_cached_display_list()
 {
     m_cached_display_list.clear();
 
@@ -6389,7 +6522,7 @@ void Document::invalidate_display_list()
         return;
 
     if (auto container = navigable->container()) {
-        container->document().invalidate_display_list();
+        container->document().clear_cached_display_list();
     }
 }
 
@@ -34,6 +34,7 @@
 #include <LibWeb/HTML/History.h>
 #include <LibWeb/HTML/LazyLoadingElement.h>
 #include <LibWeb/HTML/NavigationType.h>
+#include <LibWeb/HTML/PreloadEntry.h>
 #include <LibWeb/HTML/SandboxingFlagSet.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/VisibilityState.h>
@@ -340,6 +341,11 @@ public:
     void invalidate_layout_tree(InvalidateLayoutTreeReason);
     void invalidate_stacking_context_tree();
 
+    // Layout boxes cache facts about their subtree that only change when the layout tree is built or styles are applied
+    // to it. Bumping the generation makes all of them stale at once.
+    u64 layout_subtree_cache_generation() const { return m_layout_subtree_cache_generation; }
+    void invalidate_layout_subtree_caches() { ++m_layout_subtree_cache_generation; }
+
     virtual bool is_child_allowed(Node const&) const override;
 
     Layout::Viewport const* layout_node() const;
@@ -720,6 +726,9 @@ public:
 
     HashMap<URL::URL, GC::Ptr<HTML::SharedResourceRequest>>& shared_resource_requests();
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    HashMap<HTML::PreloadKey, GC::Ref<HTML::PreloadEntry>>& map_of_preloaded_resources() { return m_map_of_preloaded_resources; }
+
     void restore_the_history_object_state(GC::Ref<HTML::SessionHistoryEntry> entry);
 
     GC::Ref<Animations::DocumentTimeline> timeline();
@@ -766,6 +775,7 @@ public:
     GC::Ptr<Element const> scrolling_element() const;
 
     void set_needs_to_resolve_paint_only_properties() { m_needs_to_resolve_paint_only_properties = true; }
+    void set_needs_display_after_resolving_paint_only_properties(Painting::Paintable& paintable) { m_paintables_needing_display_after_resolving_paint_only_properties.set(paintable); }
     void set_needs_animated_style_update() { m_needs_animated_style_update = true; }
 
     virtual JS::Value named_item_value(FlyString const& name) const override;
@@ -928,6 +938,8 @@ private:
 
     void tear_down_layout_tree();
 
+    void clear_cached_display_list();
+
     void update_active_element();
 
     void run_unloading_cleanup_steps();
@@ -976,6 +988,7 @@ private:
     GC::Ptr<HTML::Window> m_window;
 
     GC::Ptr<Layout::Viewport> m_layout_root;
+    u64 m_layout_subtree_cache_generation { 1 };
 
     GC::Ptr<Node> m_hovered_node;
     GC::Ptr<Node> m_inspected_node;
@@ -1170,6 +1183,9 @@ private:
 
     HashMap<URL::URL, GC::Ptr<HTML::SharedResourceRequest>> m_shared_resource_requests;
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    HashMap<HTML::PreloadKey, GC::Ref<HTML::PreloadEntry>> m_map_of_preloaded_resources;
+
     // https://www.w3.org/TR/web-animations-1/#timeline-associated-with-a-document
     HashTable<GC::Ref<Animations::AnimationTimeline>> m_associated_animation_timelines;
 
@@ -1197,6 +1213,9 @@ private:
 
     bool m_needs_to_resolve_paint_only_properties { true };
 
+    // Paintables whose box shadows or outlines may have grown, so their new paint rects have to be damaged as well.
+    HashTable<GC::Ref<Painting::Paintable>> m_paintables_needing_display_after_resolving_paint_only_properties;
+
     mutable GC::Ptr<WebIDL::ObservableArray> m_adopted_style_sheets;
 
     ShadowRoot::DocumentShadowRootList m_shadow_roots;
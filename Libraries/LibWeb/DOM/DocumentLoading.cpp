@@ -91,20 +91,29 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_html_document(HTML::Navi
     //    document's relevant global object to have the parser to process the implied EOF character, which eventually
     //    causes a load event to be fired.
     else {
-        // FIXME: Parse as we receive the document data, instead of waiting for the whole document to be fetched first.
-        auto process_body = GC::create_function(document->heap(), [document, url = navigation_params.response->url().value(), mime_type = navigation_params.response->header_list()->extract_mime_type()](ByteBuffer data) {
-            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(document->heap(), [document = document, data = move(data), url = url, mime_type] {
-                auto parser = HTML::HTMLParser::create_with_uncertain_encoding(document, data, mime_type);
-                parser->run(url);
+        auto parser = HTML::HTMLParser::create_for_incremental_input(document, navigation_params.response->url().value(), navigation_params.response->header_list()->extract_mime_type());
+
+        auto process_body_chunk = GC::create_function(document->heap(), [parser](ByteBuffer chunk) {
+            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(parser->heap(), [parser, chunk = move(chunk)] {
+                parser->append_bytes_to_input_stream(chunk);
+            }));
+        });
+
+        auto process_end_of_body = GC::create_function(document->heap(), [parser] {
+            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(parser->heap(), [parser] {
+                parser->close_input_stream();
             }));
         });
 
-        auto process_body_error = GC::create_function(document->heap(), [](JS::Value) {
+        auto process_body_error = GC::create_function(document->heap(), [parser](JS::Value) {
             dbgln("FIXME: Load html page with an error if read of body failed.");
+            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(parser->heap(), [parser] {
+                parser->close_input_stream();
+            }));
         });
 
         auto& realm = document->realm();
-        navigation_params.response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+        navigation_params.response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
     }
 
     // 4. Return document.
@@ -237,8 +246,13 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_text_document(HTML::Navi
         parser->tokenizer().insert_input_at_insertion_point("<pre>\n"sv);
         parser->run();
 
+        // NOTE: The tokenizer takes UTF-8, so the text is decoded from the encoding it was sniffed to be in first.
+        auto decoder = TextCodec::decoder_for(encoding);
+        VERIFY(decoder.has_value());
+        auto text = MUST(decoder->to_utf8(data));
+
         parser->tokenizer().switch_to(HTML::HTMLTokenizer::State::PLAINTEXT);
-        parser->tokenizer().insert_input_at_insertion_point(data);
+        parser->tokenizer().insert_input_at_insertion_point(text);
         parser->tokenizer().insert_eof();
         parser->run(url);
 
@@ -701,11 +701,17 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.repaint)
         document().set_needs_to_resolve_paint_only_properties();
 
+    // NOTE: Without a paintable of our own, there is no rect to damage for whatever paints on our behalf.
+    if (invalidation.repaint && !paintable() && !m_computed_properties->display().is_none())
+        invalidation.repaint_whole_viewport = true;
+
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_properties);
-        if (invalidation.repaint && paintable())
+        if (invalidation.repaint && paintable()) {
             paintable()->set_needs_display();
+            document().set_needs_display_after_resolving_paint_only_properties(*paintable());
+        }
 
         // Do the same for pseudo-elements.
         for (auto i = 0; i < to_underlying(CSS::PseudoElement::KnownPseudoElementCount); i++) {
@@ -720,8 +726,10 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
 
             if (auto* node_with_style = dynamic_cast<Layout::NodeWithStyle*>(pseudo_element->layout_node.ptr())) {
                 node_with_style->apply_style(*pseudo_element_style);
-                if (invalidation.repaint && node_with_style->first_paintable())
+                if (invalidation.repaint && node_with_style->first_paintable()) {
                     node_with_style->first_paintable()->set_needs_display();
+                    document().set_needs_display_after_resolving_paint_only_properties(*node_with_style->first_paintable());
+                }
             }
         }
     }
@@ -770,6 +778,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_inherited_style()
         return invalidation;
 
     layout_node()->apply_style(*computed_properties);
+    if (invalidation.repaint && paintable())
+        paintable()->set_needs_display();
     return invalidation;
 }
 
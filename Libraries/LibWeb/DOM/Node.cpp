@@ -54,6 +54,7 @@
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Layout/TextNode.h>
 #include <LibWeb/MathML/MathMLElement.h>
@@ -664,6 +665,37 @@ WebIDL::ExceptionOr<void> Node::ensure_pre_insertion_validity(GC::Ref<Node> node
     return {};
 }
 
+// Returns whether the layout nodes of children appended to parent can simply be appended to parent's layout node, which
+// gives the same layout tree as building all of parent's children again.
+static bool can_append_layout_nodes_for_appended_children(Node const& parent)
+{
+    auto const* element = as_if<Element>(parent);
+    if (!element || element->is_shadow_host() || element->is_svg_element() || element->is_html_button_element() || is<HTML::HTMLSlotElement>(*element))
+        return false;
+
+    auto const* layout_node = as_if<Layout::BlockContainer>(element->layout_node());
+    if (!layout_node || layout_node->is_anonymous() || layout_node->is_fieldset_box() || !layout_node->can_have_children())
+        return false;
+    auto display = layout_node->display();
+    if (!display.is_flow_inside() && !display.is_flow_root_inside())
+        return false;
+    if (layout_node->computed_values().content_visibility() == CSS::ContentVisibility::Hidden)
+        return false;
+
+    // NOTE: The ::after pseudo-element has to stay behind the children.
+    if (element->get_pseudo_element_node(CSS::PseudoElement::After))
+        return false;
+
+    // NOTE: Anonymous boxes other than wrappers for inline content, like anonymous tables, would not be extended to take
+    //       in the new children.
+    if (auto const* last_child = layout_node->last_child(); last_child && last_child->is_anonymous()) {
+        if (!is<Layout::BlockContainer>(*last_child) || !last_child->children_are_inline())
+            return false;
+    }
+
+    return true;
+}
+
 // https://dom.spec.whatwg.org/#concept-node-insert
 void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_observers)
 {
@@ -813,7 +845,20 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
         if (layout_node() && layout_node()->display().is_contents() && parent_element()) {
             parent_element()->set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeInsertBeforeWithDisplayContents);
         }
-        set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeInsertBefore);
+
+        // OPTIMIZATION: Appending to a block container is common (think of feeds and logs), and only needs layout nodes
+        //               for the new children. Everything else builds all of our children again.
+        if (!child && can_append_layout_nodes_for_appended_children(*this)) {
+            for (auto& inserted_node : nodes)
+                inserted_node->set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeInsertBefore);
+
+            // NOTE: A node that was removed before the layout tree was updated may still be marked as needing an
+            //       update, in which case marking it again doesn't reach its new ancestors.
+            for (Node* ancestor = this; ancestor && !ancestor->child_needs_layout_tree_update(); ancestor = ancestor->parent_or_shadow_host())
+                ancestor->set_child_needs_layout_tree_update(true);
+        } else {
+            set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeInsertBefore);
+        }
     }
 
     document().bump_dom_tree_version();
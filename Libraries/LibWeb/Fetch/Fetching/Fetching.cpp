@@ -44,6 +44,7 @@
 #include <LibWeb/FileAPI/Blob.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/PreloadEntry.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
@@ -165,13 +166,14 @@ WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& r
         //    response: set fetchParams’s preloaded response candidate to response.
         auto on_preloaded_response_available = GC::create_function(realm.heap(), [fetch_params](GC::Ref<Infrastructure::Response> response) {
             fetch_params->set_preloaded_response_candidate(response);
+            if (auto callback = fetch_params->on_preloaded_response_candidate_available())
+                callback->function()();
         });
 
-        // FIXME: 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
+        // 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
         //    window, given request’s URL, request’s destination, request’s mode, request’s credentials mode,
         //    request’s integrity metadata, and onPreloadedResponseAvailable.
-        auto found_preloaded_resource = false;
-        (void)on_preloaded_response_available;
+        auto found_preloaded_resource = HTML::consume_a_preloaded_resource(*request.window().get<GC::Ptr<HTML::EnvironmentSettingsObject>>(), request.url(), request.destination(), request.mode(), request.credentials_mode(), request.integrity_metadata(), on_preloaded_response_available);
 
         // 4. If foundPreloadedResource is true and fetchParams’s preloaded response candidate is null, then set
         //    fetchParams’s preloaded response candidate to "pending".
@@ -345,9 +347,16 @@ WebIDL::ExceptionOr<GC::Ptr<PendingResponse>> main_fetch(JS::Realm& realm, Infra
         // -> fetchParams’s preloaded response candidate is not null
         if (!fetch_params.preloaded_response_candidate().has<Empty>()) {
             // 1. Wait until fetchParams’s preloaded response candidate is not "pending".
-            HTML::main_thread_event_loop().spin_until(GC::create_function(vm.heap(), [&] {
-                return !fetch_params.preloaded_response_candidate().has<Infrastructure::FetchParams::PreloadedResponseCandidatePendingTag>();
-            }));
+            // NOTE: Rather than spinning the event loop, hand out a pending response that resolves once the speculative
+            //       fetch that this request consumed has finished.
+            if (fetch_params.preloaded_response_candidate().has<Infrastructure::FetchParams::PreloadedResponseCandidatePendingTag>()) {
+                auto pending_response = PendingResponse::create(vm, request);
+                fetch_params.set_on_preloaded_response_candidate_available(GC::create_function(vm.heap(), [fetch_params = GC::Ref { fetch_params }, pending_response] {
+                    fetch_params->set_on_preloaded_response_candidate_available({});
+                    pending_response->resolve(fetch_params->preloaded_response_candidate().get<GC::Ref<Infrastructure::Response>>());
+                }));
+                return pending_response;
+            }
 
             // 2. Assert: fetchParams’s preloaded response candidate is a response.
             VERIFY(fetch_params.preloaded_response_candidate().has<GC::Ref<Infrastructure::Response>>());
@@ -2299,6 +2308,11 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
 
+    // NOTE: The HTTP cache in RequestServer is partitioned the same way as ours, by the network partition key.
+    //       Opaque origins don't get a partition, since they'd all end up sharing the same one.
+    if (auto key = Infrastructure::determine_the_network_partition_key(*request); key.has_value() && !key->top_level_origin.is_opaque())
+        load_request.set_http_cache_partition(key->top_level_origin.serialize().to_byte_string());
+
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
 
@@ -2437,18 +2451,31 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
 
         ResourceLoader::the().load_unbuffered(load_request, on_headers_received, on_data_received, on_complete);
     } else {
-        auto on_load_success = GC::create_function(vm.heap(), [&realm, &vm, request, pending_response, fetch_timing_info, cross_origin_isolated_capability](ReadonlyBytes data, Requests::RequestTimingInfo const& timing_info, HTTP::HeaderMap const& response_headers, Optional<u32> status_code, Optional<String> const& reason_phrase) {
+        auto on_load_success = GC::create_function(vm.heap(), [&realm, &vm, request, pending_response, fetch_timing_info, cross_origin_isolated_capability](ByteBuffer data, Requests::RequestTimingInfo const& timing_info, HTTP::HeaderMap const& response_headers, Optional<u32> status_code, Optional<String> const& reason_phrase) {
             (void)request;
             dbgln_if(WEB_FETCH_DEBUG, "Fetch: ResourceLoader load for '{}' complete", request->url());
             if constexpr (WEB_FETCH_DEBUG)
                 log_response(status_code, response_headers, data);
-            auto [body, _] = TRY_OR_IGNORE(extract_body(realm, data));
+
+            auto decoded_size = data.size();
+
+            // OPTIMIZATION: Large responses are moved into the body's stream, rather than also being copied into the
+            //               body's source. This keeps a single copy of the response around, at the cost of not storing
+            //               it in the HTTP memory cache. RequestServer's disk cache will still have it.
+            static constexpr size_t maximum_size_of_response_to_keep_as_source = 1 * MiB;
+
+            GC::Ptr<Infrastructure::Body> body;
+            if (decoded_size > maximum_size_of_response_to_keep_as_source)
+                body = Infrastructure::byte_sequence_as_streamed_body(realm, move(data));
+            else
+                body = TRY_OR_IGNORE(extract_body(realm, data.bytes())).body;
+
             auto response = Infrastructure::Response::create(vm);
             response->set_status(status_code.value_or(200));
-            response->set_body(move(body));
+            response->set_body(*body);
             auto body_info = response->body_info();
             body_info.encoded_size = timing_info.encoded_body_size;
-            body_info.decoded_size = data.size();
+            body_info.decoded_size = decoded_size;
             response->set_body_info(body_info);
             for (auto const& [name, value] : response_headers.headers()) {
                 auto header = Infrastructure::Header::from_latin1_pair(name, value);
@@ -40,6 +40,7 @@ void FetchParams::visit_edges(JS::Cell::Visitor& visitor)
         visitor.visit(m_task_destination.get<GC::Ref<JS::Object>>());
     if (m_preloaded_response_candidate.has<GC::Ref<Response>>())
         visitor.visit(m_preloaded_response_candidate.get<GC::Ref<Response>>());
+    visitor.visit(m_on_preloaded_response_candidate_available);
 }
 
 // https://fetch.spec.whatwg.org/#fetch-params-aborted
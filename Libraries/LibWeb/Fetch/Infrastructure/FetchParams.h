@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <LibGC/Function.h>
 #include <LibGC/Ptr.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
@@ -47,6 +48,11 @@ public:
     [[nodiscard]] PreloadedResponseCandidate const& preloaded_response_candidate() const { return m_preloaded_response_candidate; }
     void set_preloaded_response_candidate(PreloadedResponseCandidate preloaded_response_candidate) { m_preloaded_response_candidate = move(preloaded_response_candidate); }
 
+    // NOTE: Non-standard. Main fetch waits for a "pending" preloaded response candidate by registering this callback,
+    //       rather than by spinning the event loop.
+    [[nodiscard]] GC::Ptr<GC::Function<void()>> on_preloaded_response_candidate_available() const { return m_on_preloaded_response_candidate_available; }
+    void set_on_preloaded_response_candidate_available(GC::Ptr<GC::Function<void()>> callback) const { m_on_preloaded_response_candidate_available = callback; }
+
     [[nodiscard]] bool is_aborted() const;
     [[nodiscard]] bool is_canceled() const;
 
@@ -99,6 +105,8 @@ private:
     // preloaded response candidate (default null)
     //     Null, "pending", or a response.
     PreloadedResponseCandidate m_preloaded_response_candidate;
+
+    mutable GC::Ptr<GC::Function<void()>> m_on_preloaded_response_candidate_available;
 };
 
 }
@@ -6,6 +6,7 @@
  */
 
 #include <LibJS/Runtime/PromiseCapability.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/BodyInit.h>
@@ -13,6 +14,7 @@
 #include <LibWeb/Fetch/Infrastructure/IncrementalReadLoopReadRequest.h>
 #include <LibWeb/Fetch/Infrastructure/Task.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Streams/ReadableStream.h>
 
 namespace Web::Fetch::Infrastructure {
@@ -138,4 +140,33 @@ GC::Ref<Body> byte_sequence_as_body(JS::Realm& realm, ReadonlyBytes bytes)
     return body;
 }
 
+// Like byte_sequence_as_body(), but the bytes are moved into the body's stream instead of being copied, and the body
+// has no source. This is what a response that was received over the network looks like as well.
+// NOTE: Without a source, the body can't be re-extracted from its bytes. It can still be read or cloned through its
+//       stream, which is all that the fetch algorithms do with response bodies.
+GC::Ref<Body> byte_sequence_as_streamed_body(JS::Realm& realm, ByteBuffer bytes)
+{
+    HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+    auto stream = realm.create<Streams::ReadableStream>(realm);
+    stream->set_up_with_byte_reading_support();
+
+    u64 length = bytes.size();
+
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, stream, bytes = move(bytes)]() mutable {
+        HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+        if (!bytes.is_empty() && !stream->is_errored()) {
+            auto array_buffer = JS::ArrayBuffer::create(stream->realm(), move(bytes));
+            auto chunk = JS::Uint8Array::create(stream->realm(), array_buffer->byte_length(), *array_buffer);
+
+            stream->enqueue(chunk).release_value_but_fixme_should_propagate_errors();
+        }
+
+        stream->close();
+    }));
+
+    return Body::create(realm.vm(), stream, Empty {}, length);
+}
+
 }
@@ -77,5 +77,6 @@ struct BodyWithType {
 };
 
 GC::Ref<Body> byte_sequence_as_body(JS::Realm&, ReadonlyBytes);
+GC::Ref<Body> byte_sequence_as_streamed_body(JS::Realm&, ByteBuffer);
 
 }
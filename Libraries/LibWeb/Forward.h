@@ -612,6 +612,7 @@ class Path2D;
 class Plugin;
 class PluginArray;
 class PopoverInvokerElement;
+class PreloadEntry;
 class PromiseRejectionEvent;
 class RadioNodeList;
 class SelectedFile;
@@ -660,6 +661,7 @@ struct OpenerPolicy;
 struct OpenerPolicyEnforcementResult;
 struct PolicyContainer;
 struct POSTResource;
+struct PreloadKey;
 struct ScrollOptions;
 struct ScrollToOptions;
 struct SerializedFormData;
@@ -844,6 +846,8 @@ namespace Web::Platform {
 class AudioCodecPlugin;
 class Timer;
 
+struct DecodedImage;
+
 }
 
 namespace Web::ReferrerPolicy {
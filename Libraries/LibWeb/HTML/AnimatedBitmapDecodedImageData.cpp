@@ -13,13 +13,14 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
-ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated, Gfx::IntSize natural_size)
 {
-    return realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, animated);
+    return realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, animated, natural_size);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, Gfx::IntSize natural_size)
     : m_frames(move(frames))
+    , m_natural_size(natural_size.is_empty() ? m_frames.first().bitmap->size(Gfx::ImageOrientation::FromDecoded) : natural_size)
     , m_loop_count(loop_count)
     , m_animated(animated)
 {
@@ -41,19 +42,29 @@ int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
     return m_frames[frame_index].duration;
 }
 
+// NOTE: The frames may have been decoded at a lower resolution than the image itself, so the intrinsic size has to
+//       come from the natural size rather than from the bitmaps.
+Gfx::IntSize AnimatedBitmapDecodedImageData::natural_size(Gfx::ImageOrientation orientation) const
+{
+    if (orientation == Gfx::ImageOrientation::FromDecoded)
+        return m_natural_size;
+    return Gfx::exif_oriented_size(m_natural_size, m_frames.first().bitmap->get_exif_orientation());
+}
+
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width(Gfx::ImageOrientation orientation) const
 {
-    return m_frames.first().bitmap->width(orientation);
+    return natural_size(orientation).width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height(Gfx::ImageOrientation orientation) const
 {
-    return m_frames.first().bitmap->height(orientation);
+    return natural_size(orientation).height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio(Gfx::ImageOrientation orientation) const
 {
-    return CSSPixels(m_frames.first().bitmap->width(orientation)) / CSSPixels(m_frames.first().bitmap->height(orientation));
+    auto size = natural_size(orientation);
+    return CSSPixels(size.width()) / CSSPixels(size.height());
 }
 
 }
@@ -21,7 +21,8 @@ public:
         int duration { 0 };
     };
 
-    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+    // natural_size is the size of the image itself, which the frames may have been decoded smaller than.
+    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated, Gfx::IntSize natural_size = {});
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -36,9 +37,12 @@ public:
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio(Gfx::ImageOrientation orientation) const override;
 
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, Gfx::IntSize natural_size);
+
+    Gfx::IntSize natural_size(Gfx::ImageOrientation) const;
 
     Vector<Frame> m_frames;
+    Gfx::IntSize m_natural_size;
     size_t m_loop_count { 0 };
     bool m_animated { false };
 };
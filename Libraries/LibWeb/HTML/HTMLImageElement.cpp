@@ -837,6 +837,24 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            // NOTE: Show whatever has been decoded so far while the rest of the image is still being fetched.
+            if (image_request != m_current_request)
+                return;
+
+            VERIFY(image_request->shared_resource_request());
+            image_request->set_image_data(image_request->shared_resource_request()->image_data());
+
+            // https://html.spec.whatwg.org/multipage/images.html#img-inc
+            // Partially available: The user agent has obtained some of the image data.
+            if (image_request->state() == ImageRequest::State::Unavailable)
+                image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+            if (auto layout_node = this->layout_node())
+                layout_node->set_needs_layout_update(DOM::SetNeedsLayoutReason::HTMLImageElementUpdateTheImageData);
+            if (auto paintable = this->paintable())
+                paintable->set_needs_display();
         });
 }
 
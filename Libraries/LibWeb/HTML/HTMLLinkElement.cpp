@@ -9,6 +9,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/Math.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Bindings/HTMLLinkElementPrototype.h>
@@ -607,7 +608,11 @@ static NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_favicon(
         return {};
     };
 
-    auto promise = Platform::ImageCodecPlugin::the().decode_image(favicon_data, move(on_successful_decode), move(on_failed_decode));
+    // OPTIMIZATION: Browser chrome shows favicons at a small size, so there is no need to decode large icons at their
+    //               full resolution.
+    static constexpr int favicon_ideal_size_in_css_pixels = 32;
+    auto ideal_size = static_cast<int>(ceil(favicon_ideal_size_in_css_pixels * document->page().client().device_pixels_per_css_pixel()));
+    auto promise = Platform::ImageCodecPlugin::the().decode_image(favicon_data, move(on_successful_decode), move(on_failed_decode), Gfx::IntSize { ideal_size, ideal_size });
 
     return promise;
 }
@@ -8,6 +8,7 @@
 
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
+#include <AK/TemporaryChange.h>
 #include <AK/Utf32View.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
@@ -37,6 +38,7 @@
 #include <LibWeb/HTML/HTMLTemplateElement.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Scripting/SimilarOriginWindowAgent.h>
@@ -3083,7 +3085,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3102,7 +3105,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    stop_the_speculative_html_parser();
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4682,6 +4686,103 @@ GC::Ref<HTMLParser> HTMLParser::create(DOM::Document& document, StringView input
     return document.realm().create<HTMLParser>(document, input, encoding);
 }
 
+GC::Ref<HTMLParser> HTMLParser::create_for_incremental_input(DOM::Document& document, URL::URL const& url, Optional<MimeSniff::MimeType> maybe_mime_type)
+{
+    auto parser = document.realm().create<HTMLParser>(document);
+    parser->m_incremental_input_mime_type = move(maybe_mime_type);
+    parser->m_tokenizer.open_input_stream();
+    document.set_url(url);
+    return parser;
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#prescan-a-byte-stream-to-determine-its-encoding
+// The prescan looks at no more than the first 1024 bytes, so we wait for that many before committing to an encoding.
+static constexpr size_t number_of_bytes_to_buffer_for_encoding_sniffing = 1024;
+
+void HTMLParser::decode_incremental_input(IsFinalChunk is_final_chunk)
+{
+    if (!m_incremental_input_encoding.has_value()) {
+        if (is_final_chunk == IsFinalChunk::No && m_undecoded_input.size() < number_of_bytes_to_buffer_for_encoding_sniffing)
+            return;
+
+        auto encoding = m_document->has_encoding()
+            ? m_document->encoding().value().to_byte_string()
+            : run_encoding_sniffing_algorithm(*m_document, m_undecoded_input, m_incremental_input_mime_type);
+        dbgln_if(HTML_PARSER_DEBUG, "The encoding sniffing algorithm returned encoding '{}'", encoding);
+
+        auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
+        VERIFY(standardized_encoding.has_value());
+        m_document->set_encoding(MUST(String::from_utf8(standardized_encoding.value())));
+        m_incremental_input_encoding = standardized_encoding->to_byte_string();
+    }
+
+    // NOTE: Only UTF-8 is fed to the tokenizer as it arrives, since it can take input that ends in the middle of a
+    //       code point. Other encodings are decoded in one go once the whole input is known.
+    String decoded_input;
+    StringView input;
+    if (*m_incremental_input_encoding == "UTF-8"sv) {
+        input = StringView { m_undecoded_input };
+        // The BOM, if any, can only appear at the very start of the input.
+        if (!m_has_decoded_incremental_input && input.starts_with("\xEF\xBB\xBF"sv))
+            input = input.substring_view(3);
+    } else if (is_final_chunk == IsFinalChunk::Yes) {
+        auto decoder = TextCodec::decoder_for(*m_incremental_input_encoding);
+        VERIFY(decoder.has_value());
+        decoded_input = MUST(decoder->to_utf8(StringView { m_undecoded_input }));
+        input = decoded_input;
+    } else {
+        return;
+    }
+
+    m_has_decoded_incremental_input = true;
+    m_tokenizer.append_to_input_stream(input);
+
+    // NOTE: Input that arrives while the parser is blocked on a script is looked at by the speculative parser right away.
+    //       Otherwise, it's kept for the next time the speculative parser starts.
+    if (m_preload_scanner)
+        m_preload_scanner->append_to_input_stream(input);
+
+    m_undecoded_input.clear();
+}
+
+void HTMLParser::run_with_available_input()
+{
+    // NOTE: Running the parser may spin the event loop (e.g. for parser-blocking scripts), during which more input can
+    //       arrive. That input is picked up by the run that is already in progress.
+    if (m_is_running_with_available_input || m_aborted || m_has_finished_incremental_input)
+        return;
+    TemporaryChange change { m_is_running_with_available_input, true };
+
+    run();
+
+    if (m_tokenizer.is_input_stream_closed()) {
+        m_has_finished_incremental_input = true;
+        m_preload_scanner = nullptr;
+        m_document->set_source(m_tokenizer.source());
+        the_end(*m_document, this);
+    }
+}
+
+void HTMLParser::append_bytes_to_input_stream(ReadonlyBytes bytes)
+{
+    if (m_tokenizer.is_input_stream_closed())
+        return;
+    m_undecoded_input.append(bytes);
+    decode_incremental_input(IsFinalChunk::No);
+    run_with_available_input();
+}
+
+void HTMLParser::close_input_stream()
+{
+    if (m_tokenizer.is_input_stream_closed())
+        return;
+    decode_incremental_input(IsFinalChunk::Yes);
+    m_tokenizer.close_input_stream();
+    if (m_preload_scanner)
+        m_preload_scanner->close_input_stream();
+    run_with_available_input();
+}
+
 enum class AttributeMode {
     No,
     Yes,
@@ -5202,6 +5303,30 @@ Optional<Color> parse_legacy_color_value(StringView string_view)
     return result;
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: Fragment parsers have all of their input up front and never block on scripts that are worth looking past.
+    if (m_parsing_fragment || m_aborted)
+        return;
+
+    // OPTIMIZATION: Instead of a full speculative parser with its own tree builder, we only tokenize the unparsed input
+    //               and start fetching the subresources it refers to, which is where most of the benefit lies.
+    if (!m_preload_scanner)
+        m_preload_scanner = make<HTMLPreloadScanner>(*m_document, m_scripting_enabled);
+    if (m_preload_scanner->is_active())
+        return;
+
+    m_preload_scanner->start(m_tokenizer);
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#stop-the-speculative-html-parser
+void HTMLParser::stop_the_speculative_html_parser()
+{
+    if (m_preload_scanner)
+        m_preload_scanner->stop();
+}
+
 JS::Realm& HTMLParser::realm()
 {
     return m_document->realm();
@@ -5213,7 +5338,8 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    stop_the_speculative_html_parser();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
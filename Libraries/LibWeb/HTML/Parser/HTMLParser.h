@@ -26,6 +26,8 @@ class SpeculativeHTMLParser;
 
 namespace Web::HTML {
 
+class HTMLPreloadScanner;
+
 #define ENUMERATE_INSERTION_MODES               \
     __ENUMERATE_INSERTION_MODE(Initial)         \
     __ENUMERATE_INSERTION_MODE(BeforeHTML)      \
@@ -63,10 +65,15 @@ public:
     static GC::Ref<HTMLParser> create_for_scripting(DOM::Document&);
     static GC::Ref<HTMLParser> create_with_uncertain_encoding(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
     static GC::Ref<HTMLParser> create(DOM::Document&, StringView input, StringView encoding);
+    static GC::Ref<HTMLParser> create_for_incremental_input(DOM::Document&, URL::URL const&, Optional<MimeSniff::MimeType> maybe_mime_type = {});
 
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
     void run(const URL::URL&, HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
 
+    // Feeds network bytes to a parser created with create_for_incremental_input(), parsing as much as is available.
+    void append_bytes_to_input_stream(ReadonlyBytes);
+    void close_input_stream();
+
     static void the_end(GC::Ref<DOM::Document>, GC::Ptr<HTMLParser> = nullptr);
 
     DOM::Document& document();
@@ -138,6 +145,16 @@ private:
 
     void stop_parsing() { m_stop_parsing = true; }
 
+    enum class IsFinalChunk {
+        No,
+        Yes,
+    };
+    void decode_incremental_input(IsFinalChunk);
+    void run_with_available_input();
+
+    void start_the_speculative_html_parser();
+    void stop_the_speculative_html_parser();
+
     void generate_implied_end_tags(FlyString const& exception = {});
     void generate_all_implied_end_tags_thoroughly();
     GC::Ref<DOM::Element> create_element_for(HTMLToken const&, Optional<FlyString> const& namespace_, DOM::Node& intended_parent);
@@ -214,6 +231,15 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    Optional<MimeSniff::MimeType> m_incremental_input_mime_type;
+    Optional<ByteString> m_incremental_input_encoding;
+    ByteBuffer m_undecoded_input;
+    bool m_has_decoded_incremental_input { false };
+    bool m_is_running_with_available_input { false };
+    bool m_has_finished_incremental_input { false };
+
+    OwnPtr<HTMLPreloadScanner> m_preload_scanner;
+
     JS::Realm& realm();
 
     GC::Ptr<DOM::Document> m_document;
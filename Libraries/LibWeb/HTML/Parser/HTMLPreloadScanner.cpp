@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/FetchController.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/PreloadEntry.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+HTMLPreloadScanner::HTMLPreloadScanner(DOM::Document& document, bool scripting_enabled)
+    : m_document(document)
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+HTMLPreloadScanner::~HTMLPreloadScanner() = default;
+
+void HTMLPreloadScanner::start(HTMLTokenizer const& parser_tokenizer)
+{
+    VERIFY(!is_active());
+    m_is_active = true;
+
+    // NOTE: If the parser has moved past the point where the previous scan stopped, the input in between has already
+    //       been fetched for real, so start over from where the parser is. The parser is blocked right after the end
+    //       tag of a script element, so the input that follows it is tokenized from the data state.
+    //       Positions are offsets into the parser's source, i.e. the input from the network without anything that was
+    //       inserted by document.write(), so our tokenizer only ever gets to see that source as well.
+    auto parser_position = parser_tokenizer.consumed_source_length();
+    if (!m_tokenizer.has_value() || scanned_source_length() < parser_position) {
+        m_tokenizer.emplace();
+        m_tokenizer->open_input_stream();
+        m_tokenizer->append_to_input_stream(parser_tokenizer.unconsumed_source());
+        m_tokenizer->append_to_input_stream(StringView { parser_tokenizer.incomplete_utf8_sequence() });
+        if (parser_tokenizer.is_input_stream_closed())
+            m_tokenizer->close_input_stream();
+        m_source_offset_of_tokenizer_input = parser_position;
+        m_base_url = m_document.base_url();
+        m_has_seen_base_element_with_href = false;
+    }
+
+    scan();
+}
+
+void HTMLPreloadScanner::stop()
+{
+    m_is_active = false;
+}
+
+void HTMLPreloadScanner::append_to_input_stream(StringView input)
+{
+    if (!m_tokenizer.has_value())
+        return;
+    m_tokenizer->append_to_input_stream(input);
+    if (is_active())
+        scan();
+}
+
+void HTMLPreloadScanner::close_input_stream()
+{
+    if (!m_tokenizer.has_value())
+        return;
+    m_tokenizer->close_input_stream();
+    if (is_active())
+        scan();
+}
+
+size_t HTMLPreloadScanner::scanned_source_length() const
+{
+    return m_source_offset_of_tokenizer_input + m_tokenizer->consumed_source_length();
+}
+
+void HTMLPreloadScanner::scan()
+{
+    for (;;) {
+        auto token = m_tokenizer->next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            return;
+        if (!token->is_start_tag())
+            continue;
+
+        process_start_tag(*token);
+
+        // NOTE: There is no tree builder to switch the tokenizer into the right state for the contents of these elements,
+        //       so do it here. Otherwise, markup inside of e.g. a script would be mistaken for elements.
+        auto const& tag_name = token->tag_name();
+        if (tag_name == HTML::TagNames::script)
+            m_tokenizer->switch_to(HTMLTokenizer::State::ScriptData);
+        else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes))
+            m_tokenizer->switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name == HTML::TagNames::noscript && m_scripting_enabled)
+            m_tokenizer->switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name.is_one_of(HTML::TagNames::textarea, HTML::TagNames::title))
+            m_tokenizer->switch_to(HTMLTokenizer::State::RCDATA);
+        else if (tag_name == HTML::TagNames::plaintext)
+            m_tokenizer->switch_to(HTMLTokenizer::State::PLAINTEXT);
+    }
+}
+
+void HTMLPreloadScanner::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    if (tag_name == HTML::TagNames::base) {
+        // NOTE: Only the first base element with an href attribute affects the document base URL.
+        auto href = token.attribute(HTML::AttributeNames::href);
+        if (!href.has_value() || m_has_seen_base_element_with_href)
+            return;
+        m_has_seen_base_element_with_href = true;
+        if (auto base_url = DOMURL::parse(*href, m_document.fallback_base_url()); base_url.has_value())
+            m_base_url = base_url.release_value();
+        return;
+    }
+
+    auto crossorigin = cors_setting_attribute_from_keyword(token.attribute(HTML::AttributeNames::crossorigin));
+
+    if (tag_name == HTML::TagNames::script) {
+        auto src = token.attribute(HTML::AttributeNames::src);
+        if (!src.has_value() || !m_scripting_enabled)
+            return;
+
+        auto type = token.attribute(HTML::AttributeNames::type);
+        if (!type.has_value() || type->is_empty() || MimeSniff::is_javascript_mime_type_essence_match(MUST(type->trim(Infra::ASCII_WHITESPACE)))) {
+            preload(*src, Fetch::Infrastructure::Request::Destination::Script, Fetch::Infrastructure::Request::InitiatorType::Script, crossorigin);
+        } else if (type->equals_ignoring_ascii_case("module"sv)) {
+            // NOTE: Module scripts are always fetched in CORS mode.
+            preload(*src, Fetch::Infrastructure::Request::Destination::Script, Fetch::Infrastructure::Request::InitiatorType::Script, crossorigin == CORSSettingAttribute::NoCORS ? CORSSettingAttribute::Anonymous : crossorigin);
+        }
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::link) {
+        auto rel = token.attribute(HTML::AttributeNames::rel);
+        auto href = token.attribute(HTML::AttributeNames::href);
+        if (!rel.has_value() || !href.has_value())
+            return;
+
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        for (auto keyword : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+            if (keyword.equals_ignoring_ascii_case("stylesheet"sv))
+                is_stylesheet = true;
+            else if (keyword.equals_ignoring_ascii_case("alternate"sv))
+                is_alternate = true;
+        }
+
+        // NOTE: Alternate style sheets are not applied by default, so they're not worth fetching early.
+        if (is_stylesheet && !is_alternate)
+            preload(*href, Fetch::Infrastructure::Request::Destination::Style, Fetch::Infrastructure::Request::InitiatorType::CSS, crossorigin);
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::img) {
+        auto src = token.attribute(HTML::AttributeNames::src);
+        if (!src.has_value())
+            return;
+
+        // NOTE: Lazily loaded images may never be fetched at all.
+        if (auto loading = token.attribute(HTML::AttributeNames::loading); loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv))
+            return;
+
+        preload(*src, Fetch::Infrastructure::Request::Destination::Image, Fetch::Infrastructure::Request::InitiatorType::IMG, crossorigin);
+        return;
+    }
+}
+
+void HTMLPreloadScanner::preload(String const& url_string, Fetch::Infrastructure::Request::Destination destination, Fetch::Infrastructure::Request::InitiatorType initiator_type, CORSSettingAttribute crossorigin)
+{
+    auto trimmed_url_string = MUST(url_string.trim(Infra::ASCII_WHITESPACE));
+    if (trimmed_url_string.is_empty())
+        return;
+
+    auto encoding = m_document.encoding_or_default();
+    auto url = DOMURL::parse(trimmed_url_string, *m_base_url, encoding.bytes_as_string_view());
+    if (!url.has_value())
+        return;
+
+    // NOTE: Only network fetches are worth starting early.
+    if (!url->scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload
+    auto& realm = m_document.realm();
+    auto request = create_potential_CORS_request(realm.vm(), *url, destination, crossorigin);
+    request->set_client(&m_document.relevant_settings_object());
+    request->set_policy_container(m_document.policy_container());
+    request->set_initiator_type(initiator_type);
+
+    // 1. Let key be a preload key whose URL is request's URL, destination is request's destination, mode is request's
+    //    mode, and credentials mode is request's credentials mode.
+    HTML::PreloadKey key { request->url(), request->destination(), request->mode(), request->credentials_mode() };
+
+    // 2. Let preloads be the document's map of preloaded resources.
+    auto& preloads = m_document.map_of_preloaded_resources();
+
+    // 3. If preloads[key] exists, then return.
+    // NOTE: This also covers anything that is found again by a scan that had to start over.
+    if (preloads.contains(key))
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "HTMLPreloadScanner: Speculatively fetching {}", *url);
+
+    // 4. Let entry be a new preload entry whose integrity metadata is request's integrity metadata.
+    auto entry = realm.heap().allocate<HTML::PreloadEntry>(request->integrity_metadata());
+
+    // 5. Set preloads[key] to entry.
+    preloads.set(key, entry);
+
+    // NOTE: The speculative fetch itself must not consume the entry it is about to fill in.
+    request->set_window(Fetch::Infrastructure::Request::Window::NoWindow);
+
+    // 6. Fetch request, with processResponseConsumeBody set to the following steps given a response response and null,
+    //    failure, or a byte sequence bodyBytes:
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [&realm, entry](GC::Ref<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+        // 1. If bodyBytes is a byte sequence, then set response's body to bodyBytes as a body.
+        if (auto* bytes = body_bytes.get_pointer<ByteBuffer>())
+            response->set_body(Fetch::Infrastructure::byte_sequence_as_body(realm, *bytes));
+        // 2. Otherwise, set response to a network error.
+        // NOTE: A null body (e.g. for a 204 response) is left alone, as there is nothing to consume.
+        else if (body_bytes.has<Fetch::Infrastructure::FetchAlgorithms::ConsumeBodyFailureTag>())
+            response = Fetch::Infrastructure::Response::network_error(realm.vm(), "Failed to read the preloaded response body"_string);
+
+        // 3. Finalize preload: if entry's on response available is null, then set entry's response to response;
+        //    otherwise call entry's on response available with response.
+        if (auto on_response_available = entry->on_response_available())
+            on_response_available->function()(response);
+        else
+            entry->set_response(response);
+    };
+    (void)Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(realm.vm(), move(fetch_algorithms_input)));
+}
+
+}
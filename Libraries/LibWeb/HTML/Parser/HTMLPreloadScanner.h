@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// Tokenizes the input that an HTML parser has not reached yet (i.e. while it is blocked on a parser-blocking script),
+// and speculatively fetches the external scripts, style sheets and images it finds. Nothing is inserted into the
+// document; the responses are put in the document's map of preloaded resources, from where the fetches that the
+// parser starts once it gets there consume them.
+class HTMLPreloadScanner {
+public:
+    HTMLPreloadScanner(DOM::Document&, bool scripting_enabled);
+    ~HTMLPreloadScanner();
+
+    void start(HTMLTokenizer const& parser_tokenizer);
+    void stop();
+    bool is_active() const { return m_is_active; }
+
+    // Feeds input that arrives from the network. It is only scanned while the scanner is active.
+    void append_to_input_stream(StringView);
+    void close_input_stream();
+
+private:
+    size_t scanned_source_length() const;
+    void scan();
+    void process_start_tag(HTMLToken const&);
+    void preload(String const& url, Fetch::Infrastructure::Request::Destination, Fetch::Infrastructure::Request::InitiatorType, CORSSettingAttribute);
+
+    DOM::Document& m_document;
+
+    // NOTE: The tokenizer is kept around between scans, so that each scan picks up where the previous one left off
+    //       instead of going over everything that follows the next parser-blocking script again.
+    Optional<HTMLTokenizer> m_tokenizer;
+    size_t m_source_offset_of_tokenizer_input { 0 };
+    bool m_is_active { false };
+
+    Optional<URL::URL> m_base_url;
+    bool m_has_seen_base_element_with_href { false };
+    bool m_scripting_enabled { true };
+};
+
+}
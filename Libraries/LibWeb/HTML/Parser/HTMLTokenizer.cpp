@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -36,6 +39,8 @@ namespace Web::HTML {
         m_state = State::new_state;                                                               \
         if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached()) \
             return {};                                                                            \
+        if (!m_input_stream_closed && is_end_of_available_input_reached())                        \
+            return {};                                                                            \
         CONSUME_NEXT_INPUT_CHARACTER;                                                             \
         goto new_state;                                                                           \
     } while (0)
@@ -193,9 +198,103 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
     dbgln_if(TOKENIZER_TRACE_DEBUG, "Parse error (tokenization) {}", location);
 }
 
+// NOTE: The input is always valid UTF-8, as it has either been decoded by us or validated on insertion.
+u32 HTMLTokenizer::code_point_at(ssize_t offset, size_t& length_in_bytes) const
+{
+    auto const* bytes = m_input.data() + offset;
+    auto lead = bytes[0];
+    if (lead < 0x80) {
+        length_in_bytes = 1;
+        return lead;
+    }
+    if ((lead & 0xE0) == 0xC0) {
+        length_in_bytes = 2;
+        return ((lead & 0x1F) << 6) | (bytes[1] & 0x3F);
+    }
+    if ((lead & 0xF0) == 0xE0) {
+        length_in_bytes = 3;
+        return ((lead & 0x0F) << 12) | ((bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+    }
+    length_in_bytes = 4;
+    return ((lead & 0x07) << 18) | ((bytes[1] & 0x3F) << 12) | ((bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+}
+
+static ALWAYS_INLINE bool is_utf8_continuation_byte(u8 byte)
+{
+    return (byte & 0xC0) == 0x80;
+}
+
+ssize_t HTMLTokenizer::offset_before_code_points(ssize_t offset, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        VERIFY(offset > 0);
+        do {
+            --offset;
+        } while (offset > 0 && is_utf8_continuation_byte(m_input[offset]));
+    }
+    return offset;
+}
+
+// Returns the length of the longest prefix of `bytes` that contains none of the given ASCII delimiters.
+template<char... Delimiters>
+static size_t length_of_run_without(ReadonlyBytes bytes)
+{
+    using AK::SIMD::u64x2;
+    using AK::SIMD::u8x16;
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= bytes.size(); offset += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(bytes.offset(offset));
+        auto matches = ((chunk == static_cast<u8>(Delimiters)) | ...);
+        auto words = bit_cast<u64x2>(matches);
+        if ((words[0] | words[1]) != 0)
+            break;
+    }
+    for (; offset < bytes.size(); ++offset) {
+        if (((bytes[offset] == static_cast<u8>(Delimiters)) || ...))
+            break;
+    }
+    return offset;
+}
+
+// OPTIMIZATION: Consumes the run of input that the current state would append to the current builder one code point
+//               at a time anyway, stopping at the given delimiters as well as at NULL, CR and LF, which need special
+//               handling or position bookkeeping.
+template<char... Delimiters>
+void HTMLTokenizer::append_run_to_current_builder(StopAtInsertionPoint stop_at_insertion_point)
+{
+    auto end = static_cast<ssize_t>(m_input.size());
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && m_insertion_point.defined)
+        end = min(end, m_insertion_point.position);
+    if (m_current_offset >= end)
+        return;
+
+    auto available_input = m_input.bytes().slice(m_current_offset, end - m_current_offset);
+    auto run_length = length_of_run_without<'\0', '\r', '\n', Delimiters...>(available_input);
+    if (run_length == 0)
+        return;
+
+    auto run = available_input.trim(run_length);
+    m_current_builder.append(StringView { run });
+
+    // NOTE: Like skip(), this keeps one source position per consumed code point, so restore_to() can take them back.
+    auto last_code_point_offset = m_current_offset;
+    for (size_t i = 0; i < run_length; ++i) {
+        if (is_utf8_continuation_byte(run[i]))
+            continue;
+        last_code_point_offset = m_current_offset + static_cast<ssize_t>(i);
+        if (!m_source_positions.is_empty()) {
+            m_source_positions.append(m_source_positions.last());
+            m_source_positions.last().column++;
+        }
+    }
+    m_prev_offset = last_code_point_offset;
+    m_current_offset += static_cast<ssize_t>(run_length);
+}
+
 Optional<u32> HTMLTokenizer::next_code_point(StopAtInsertionPoint stop_at_insertion_point)
 {
-    if (m_current_offset >= static_cast<ssize_t>(m_decoded_input.size()))
+    if (m_current_offset >= static_cast<ssize_t>(m_input.size()))
         return {};
 
     u32 code_point;
@@ -211,7 +310,8 @@ Optional<u32> HTMLTokenizer::next_code_point(StopAtInsertionPoint stop_at_insert
         code_point = '\n';
     } else {
         skip(1);
-        code_point = m_decoded_input[m_prev_offset];
+        size_t length_in_bytes = 0;
+        code_point = code_point_at(m_prev_offset, length_in_bytes);
     }
 
     dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Next code_point: {}", code_point);
@@ -220,12 +320,13 @@ Optional<u32> HTMLTokenizer::next_code_point(StopAtInsertionPoint stop_at_insert
 
 void HTMLTokenizer::skip(size_t count)
 {
-    if (!m_source_positions.is_empty())
-        m_source_positions.append(m_source_positions.last());
     for (size_t i = 0; i < count; ++i) {
         m_prev_offset = m_current_offset;
-        auto code_point = m_decoded_input[m_current_offset];
+        size_t length_in_bytes = 0;
+        auto code_point = code_point_at(m_current_offset, length_in_bytes);
+        // NOTE: There is one source position per consumed code point, so restore_to() can take them back one by one.
         if (!m_source_positions.is_empty()) {
+            m_source_positions.append(m_source_positions.last());
             if (code_point == '\n') {
                 m_source_positions.last().column = 0;
                 m_source_positions.last().line++;
@@ -233,21 +334,30 @@ void HTMLTokenizer::skip(size_t count)
                 m_source_positions.last().column++;
             }
         }
-        ++m_current_offset;
+        m_current_offset += length_in_bytes;
     }
 }
 
 Optional<u32> HTMLTokenizer::peek_code_point(ssize_t offset, StopAtInsertionPoint stop_at_insertion_point) const
 {
-    auto it = m_current_offset + offset;
-    if (it >= static_cast<ssize_t>(m_decoded_input.size()))
+    VERIFY(offset >= 0);
+    auto input_size = static_cast<ssize_t>(m_input.size());
+    auto it = m_current_offset;
+    size_t length_in_bytes = 0;
+    for (ssize_t i = 0; i < offset; ++i) {
+        if (it >= input_size)
+            return {};
+        (void)code_point_at(it, length_in_bytes);
+        it += length_in_bytes;
+    }
+    if (it >= input_size)
         return {};
     if (stop_at_insertion_point == StopAtInsertionPoint::Yes
         && m_insertion_point.defined
         && it >= m_insertion_point.position) {
         return {};
     }
-    return m_decoded_input[it];
+    return code_point_at(it, length_in_bytes);
 }
 
 HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
@@ -277,6 +387,9 @@ _StartOfFunction:
         if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached())
             return {};
 
+        if (!m_input_stream_closed && is_end_of_available_input_reached())
+            return {};
+
         auto current_input_character = next_code_point(stop_at_insertion_point);
         switch (m_state) {
             // 13.2.5.1 Data state, https://html.spec.whatwg.org/multipage/parsing.html#data-state
@@ -1315,6 +1428,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_run_to_current_builder<'"', '&'>(stop_at_insertion_point);
                     continue;
                 }
             }
@@ -1347,6 +1461,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_run_to_current_builder<'\'', '&'>(stop_at_insertion_point);
                     continue;
                 }
             }
@@ -1696,6 +1811,11 @@ _StartOfFunction:
             // 13.2.5.73 Named character reference state, https://html.spec.whatwg.org/multipage/parsing.html#named-character-reference-state
             BEGIN_STATE(NamedCharacterReference)
             {
+                // NOTE: Whether a match is the longest one, and (inside an attribute value) what follows it, can only be
+                //       decided once the code point after the consumed ones is known. Wait for more input until then.
+                if (!current_input_character.has_value() && !m_input_stream_closed)
+                    return {};
+
                 if (current_input_character.has_value()) {
                     if (m_named_character_reference_matcher.try_consume_code_point(current_input_character.value())) {
                         m_temporary_buffer.append(current_input_character.value());
@@ -1710,8 +1830,7 @@ _StartOfFunction:
                 // have lead to `&notindot;`) would need to backtrack back to `&not`),
                 auto overconsumed_code_points = m_named_character_reference_matcher.overconsumed_code_points();
                 if (overconsumed_code_points > 0) {
-                    auto current_byte_offset = m_current_offset;
-                    restore_to(current_byte_offset - overconsumed_code_points);
+                    restore_to(offset_before_code_points(m_current_offset, overconsumed_code_points));
                     m_temporary_buffer.resize_and_keep_capacity(m_temporary_buffer.size() - overconsumed_code_points);
                 }
 
@@ -2822,7 +2941,7 @@ HTMLTokenizer::ConsumeNextResult HTMLTokenizer::consume_next_if_match(StringView
     for (size_t i = 0; i < string.length(); ++i) {
         auto code_point = peek_code_point(i, stop_at_insertion_point);
         if (!code_point.has_value()) {
-            if (StopAtInsertionPoint::Yes == stop_at_insertion_point) {
+            if (StopAtInsertionPoint::Yes == stop_at_insertion_point || !m_input_stream_closed) {
                 return ConsumeNextResult::RanOutOfCharacters;
             }
             return ConsumeNextResult::NotConsumed;
@@ -2852,7 +2971,6 @@ void HTMLTokenizer::create_new_token(HTMLToken::Type type)
 
 HTMLTokenizer::HTMLTokenizer()
 {
-    m_decoded_input = {};
     m_current_offset = 0;
     m_prev_offset = 0;
     m_source_positions.empend(0u, 0u);
@@ -2862,10 +2980,7 @@ HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
 {
     auto decoder = TextCodec::decoder_for(encoding);
     VERIFY(decoder.has_value());
-    m_source = MUST(decoder->to_utf8(input));
-    m_decoded_input.ensure_capacity(m_source.bytes().size());
-    for (auto code_point : m_source.code_points())
-        m_decoded_input.append(code_point);
+    m_input = MUST(ByteBuffer::copy(MUST(decoder->to_utf8(input)).bytes()));
     m_current_offset = 0;
     m_prev_offset = 0;
     m_source_positions.empend(0u, 0u);
@@ -2873,24 +2988,113 @@ HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
 
 void HTMLTokenizer::insert_input_at_insertion_point(StringView input)
 {
-    Vector<u32> new_decoded_input;
-    new_decoded_input.ensure_capacity(m_decoded_input.size() + input.length());
+    // NOTE: The rest of the tokenizer decodes the input without bounds checks, so it must be valid UTF-8.
+    VERIFY(Utf8View { input }.validate());
+
+    auto position = static_cast<size_t>(m_insertion_point.position);
+    auto length_after_insertion_point = m_input.size() - position;
+    m_input.resize(m_input.size() + input.length());
+    memmove(m_input.data() + position + input.length(), m_input.data() + position, length_after_insertion_point);
+    memcpy(m_input.data() + position, input.characters_without_null_termination(), input.length());
+
+    m_inserted_input_ranges.append({ position, input.length() });
+    m_insertion_point.position += input.length();
+}
+
+String HTMLTokenizer::source() const
+{
+    // NOTE: Only the input itself is kept around, so the source is recovered by taking out everything that was
+    //       inserted at the insertion point (i.e. by document.write()), most recent insertion first.
+    if (m_inserted_input_ranges.is_empty())
+        return String::from_utf8_without_validation(m_input.bytes());
+
+    auto source = MUST(ByteBuffer::copy(m_input.bytes()));
+    for (auto const& range : m_inserted_input_ranges.in_reverse()) {
+        auto length_after_range = source.size() - range.position - range.length;
+        memmove(source.data() + range.position, source.data() + range.position + range.length, length_after_range);
+        source.resize(source.size() - range.length);
+    }
+    return String::from_utf8_without_validation(source.bytes());
+}
+
+size_t HTMLTokenizer::consumed_source_length() const
+{
+    // NOTE: This maps the current position back into source(), the same way source() takes out the inserted input.
+    auto position = min(static_cast<size_t>(m_current_offset), m_input.size());
+    for (auto const& range : m_inserted_input_ranges.in_reverse()) {
+        if (position >= range.position + range.length)
+            position -= range.length;
+        else if (position > range.position)
+            position = range.position;
+    }
+    return position;
+}
+
+String HTMLTokenizer::unconsumed_source() const
+{
+    return MUST(source().substring_from_byte_offset(consumed_source_length()));
+}
 
-    auto before = m_decoded_input.span().slice(0, m_insertion_point.position);
-    new_decoded_input.append(before.data(), before.size());
+static size_t length_of_incomplete_utf8_sequence_at_end(ReadonlyBytes bytes)
+{
+    for (size_t i = 1; i <= min(bytes.size(), 4uz); ++i) {
+        auto byte = bytes[bytes.size() - i];
+        if (is_utf8_continuation_byte(byte))
+            continue;
+
+        size_t sequence_length = 1;
+        if ((byte & 0xE0) == 0xC0)
+            sequence_length = 2;
+        else if ((byte & 0xF0) == 0xE0)
+            sequence_length = 3;
+        else if ((byte & 0xF8) == 0xF0)
+            sequence_length = 4;
+        return sequence_length > i ? i : 0;
+    }
+    return 0;
+}
 
-    auto utf8_to_insert = MUST(String::from_utf8(input));
-    ssize_t code_points_inserted = 0;
-    for (auto code_point : utf8_to_insert.code_points()) {
-        new_decoded_input.append(code_point);
-        ++code_points_inserted;
+void HTMLTokenizer::append_to_input_stream(StringView input)
+{
+    VERIFY(!m_input_stream_closed);
+
+    // NOTE: Input arrives in arbitrary chunks, so a code point may be split across two of them. Its leading bytes are
+    //       held back until the rest of it arrives.
+    ByteBuffer joined_input;
+    if (!m_incomplete_utf8_sequence.is_empty()) {
+        joined_input = move(m_incomplete_utf8_sequence);
+        joined_input.append(input.bytes());
+        input = StringView { joined_input };
     }
+    auto incomplete_length = length_of_incomplete_utf8_sequence_at_end(input.bytes());
+    m_incomplete_utf8_sequence = MUST(ByteBuffer::copy(input.bytes().slice(input.length() - incomplete_length)));
+    input = input.substring_view(0, input.length() - incomplete_length);
+
+    auto decoded_input = String::from_utf8_with_replacement_character(input, String::WithBOMHandling::No);
+    m_input.append(decoded_input.bytes());
+}
 
-    auto after = m_decoded_input.span().slice(m_insertion_point.position);
-    new_decoded_input.append(after.data(), after.size());
-    m_decoded_input = move(new_decoded_input);
+void HTMLTokenizer::close_input_stream()
+{
+    VERIFY(!m_input_stream_closed);
 
-    m_insertion_point.position += code_points_inserted;
+    // A code point that was cut off by the end of the input is replaced, just like any other invalid sequence.
+    if (!m_incomplete_utf8_sequence.is_empty()) {
+        m_incomplete_utf8_sequence.clear();
+        m_input.append("\xEF\xBF\xBD"sv.bytes());
+    }
+
+    m_input_stream_closed = true;
+}
+
+bool HTMLTokenizer::is_end_of_available_input_reached() const
+{
+    auto remaining_bytes = static_cast<ssize_t>(m_input.size()) - m_current_offset;
+    if (remaining_bytes <= 0)
+        return true;
+
+    // NOTE: A CR at the end of the available input may be the first half of a CRLF pair that has yet to arrive.
+    return remaining_bytes == 1 && m_input.bytes().last() == '\r';
 }
 
 void HTMLTokenizer::insert_eof()
@@ -2946,9 +3150,10 @@ bool HTMLTokenizer::consumed_as_part_of_an_attribute() const
 
 void HTMLTokenizer::restore_to(ssize_t new_iterator)
 {
-    auto diff = m_current_offset - new_iterator;
-    if (diff > 0) {
-        for (ssize_t i = 0; i < diff; ++i) {
+    if (new_iterator < m_current_offset) {
+        for (ssize_t i = new_iterator; i < m_current_offset; ++i) {
+            if (is_utf8_continuation_byte(m_input[i]))
+                continue;
             if (!m_source_positions.is_empty())
                 m_source_positions.take_last();
         }
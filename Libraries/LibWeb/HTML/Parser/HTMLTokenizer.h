@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Queue.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
@@ -128,12 +129,34 @@ public:
     void set_blocked(bool b) { m_blocked = b; }
     bool is_blocked() const { return m_blocked; }
 
-    auto const& source() const { return m_source; }
+    // The input as it was given to the tokenizer, without anything inserted at the insertion point.
+    String source() const;
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
 
+    // https://html.spec.whatwg.org/multipage/parsing.html#the-input-byte-stream
+    // While the input stream is open, running out of input pauses the tokenizer instead of producing an EOF token.
+    // Appended input is UTF-8, and may end in the middle of a code point.
+    void open_input_stream() { m_input_stream_closed = false; }
+    void append_to_input_stream(StringView input);
+    void close_input_stream();
+    bool is_input_stream_closed() const { return m_input_stream_closed; }
+
+    // The input that has not been consumed yet, e.g. for looking ahead while the tokenizer is blocked.
+    StringView unconsumed_input() const { return StringView { m_input.bytes().slice(min(static_cast<size_t>(m_current_offset), m_input.size())) }; }
+
+    // The bytes at the end of the appended input that don't form a complete code point yet.
+    ReadonlyBytes incomplete_utf8_sequence() const { return m_incomplete_utf8_sequence.bytes(); }
+
+    // The length of the part of source() that has been consumed.
+    size_t consumed_source_length() const;
+
+    // The part of source() that has not been consumed yet. Unlike unconsumed_input(), this leaves out everything that
+    // was inserted at the insertion point.
+    String unconsumed_source() const;
+
     bool is_insertion_point_defined() const { return m_insertion_point.defined; }
     bool is_insertion_point_reached()
     {
@@ -153,6 +176,11 @@ public:
 
 private:
     void skip(size_t count);
+    bool is_end_of_available_input_reached() const;
+    u32 code_point_at(ssize_t offset, size_t& length_in_bytes) const;
+    ssize_t offset_before_code_points(ssize_t offset, size_t count) const;
+    template<char... Delimiters>
+    void append_run_to_current_builder(StopAtInsertionPoint);
     Optional<u32> next_code_point(StopAtInsertionPoint);
     Optional<u32> peek_code_point(ssize_t offset, StopAtInsertionPoint) const;
 
@@ -195,8 +223,14 @@ private:
 
     Vector<u32> m_temporary_buffer;
 
-    String m_source;
-    Vector<u32> m_decoded_input;
+    // The UTF-8 encoded input stream. All offsets into the input, including the insertion point, are byte offsets.
+    ByteBuffer m_input;
+
+    struct InsertedInputRange {
+        size_t position { 0 };
+        size_t length { 0 };
+    };
+    Vector<InsertedInputRange> m_inserted_input_ranges;
 
     struct InsertionPoint {
         ssize_t position { 0 };
@@ -216,6 +250,8 @@ private:
     Optional<FlyString> m_last_emitted_start_tag_name;
 
     bool m_explicit_eof_inserted { false };
+    bool m_input_stream_closed { true };
+    ByteBuffer m_incomplete_utf8_sequence;
     bool m_has_emitted_eof { false };
 
     Queue<HTMLToken> m_queued_tokens;
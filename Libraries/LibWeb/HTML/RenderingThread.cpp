@@ -4,13 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
 #include <LibWeb/HTML/RenderingThread.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Painting/BackingStore.h>
 
 namespace Web::HTML {
 
+static constexpr int tile_size = 512;
+static constexpr unsigned max_rasterization_threads = 8;
+
 RenderingThread::RenderingThread()
     : m_main_thread_event_loop(Core::EventLoop::current())
     , m_main_thread_exit_promise(Core::Promise<NonnullRefPtr<Core::EventReceiver>>::construct())
@@ -35,6 +40,21 @@ void RenderingThread::start(DisplayListPlayerType display_list_player_type)
 {
     m_display_list_player_type = display_list_player_type;
     VERIFY(m_skia_player);
+
+    // OPTIMIZATION: Without a GPU, rasterizing large frames on a single thread is slow. We split those frames into
+    //               tiles and paint them on a few worker threads, in addition to the rendering thread itself.
+    if (m_display_list_player_type == DisplayListPlayerType::SkiaCPU || !m_skia_backend_context) {
+        auto thread_count = min(Core::System::hardware_concurrency(), max_rasterization_threads);
+        for (unsigned i = 1; i < thread_count; ++i) {
+            auto worker_thread = Threading::WorkerThread<Error>::create("TileRasterizer"sv);
+            if (worker_thread.is_error()) {
+                dbgln("Failed to create tile rasterization thread: {}", worker_thread.error());
+                break;
+            }
+            m_tile_workers.append({ worker_thread.release_value(), make<Painting::DisplayListPlayerSkia>() });
+        }
+    }
+
     m_thread = Threading::Thread::construct([this] {
         rendering_thread_loop();
         return static_cast<intptr_t>(0);
@@ -49,6 +69,7 @@ void RenderingThread::rendering_thread_loop()
             Threading::MutexLocker const locker { m_rendering_task_mutex };
             if (m_needs_to_clear_bitmap_to_surface_cache) {
                 m_bitmap_to_surface.clear();
+                m_damage_tracker.did_forget_all_backing_stores();
                 m_needs_to_clear_bitmap_to_surface_cache = false;
             }
             while (m_rendering_tasks.is_empty() && !m_exit) {
@@ -64,8 +85,32 @@ void RenderingThread::rendering_thread_loop()
             break;
         }
 
-        auto painting_surface = painting_surface_for_backing_store(task->backing_store);
-        m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, painting_surface);
+        auto& cached_surface = painting_surface_for_backing_store(task->backing_store);
+        auto& bitmap = task->backing_store->bitmap();
+        Gfx::IntRect surface_rect { {}, cached_surface.surface->size() };
+
+        // OPTIMIZATION: The backing store still contains the frame that was last painted into it, so we only have to
+        //               repaint what changed since then. That is the damage of this frame, plus the damage of any
+        //               frames that were painted into other backing stores in the meantime.
+        auto repaint_rect = m_damage_tracker.rect_to_repaint(bitmap, task->damaged_rect);
+
+        if (!repaint_rect.has_value() || !repaint_rect->is_empty()) {
+            if (!paint_in_tiles(*task->display_list, task->scroll_state_snapshot, cached_surface, repaint_rect.value_or(surface_rect)))
+                m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, cached_surface.surface, repaint_rect);
+        }
+
+        // NOTE: Tasks without damage (e.g. screenshots) are one-off paints that don't represent a new frame.
+        if (task->damaged_rect.has_value()) {
+            m_damage_tracker.did_paint_frame(bitmap, *task->damaged_rect);
+
+            if constexpr (PAINT_DAMAGE_DEBUG) {
+                // Tint the damaged rect, and make sure it's repainted without the tint the next time this backing store is used.
+                auto overlay = Painting::DisplayList::create();
+                overlay->append(Painting::FillRect { *task->damaged_rect, Color(255, 0, 255, 80) }, {});
+                m_skia_player->execute(*overlay, {}, cached_surface.surface);
+                m_damage_tracker.add_damage(bitmap, *task->damaged_rect);
+            }
+        }
         if (m_exit)
             break;
         m_main_thread_event_loop.deferred_invoke([callback = move(task->callback)] {
@@ -74,14 +119,56 @@ void RenderingThread::rendering_thread_loop()
     }
 }
 
-void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList> display_list, Painting::ScrollStateSnapshot&& scroll_state_snapshot, NonnullRefPtr<Painting::BackingStore> backing_store, Function<void()>&& callback)
+void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList> display_list, Painting::ScrollStateSnapshot&& scroll_state_snapshot, NonnullRefPtr<Painting::BackingStore> backing_store, Optional<Gfx::IntRect> damaged_rect, Function<void()>&& callback)
 {
     Threading::MutexLocker const locker { m_rendering_task_mutex };
-    m_rendering_tasks.enqueue(Task { move(display_list), move(scroll_state_snapshot), move(backing_store), move(callback) });
+    m_rendering_tasks.enqueue(Task { move(display_list), move(scroll_state_snapshot), move(backing_store), damaged_rect, move(callback) });
     m_rendering_task_ready_wake_condition.signal();
 }
 
-NonnullRefPtr<Gfx::PaintingSurface> RenderingThread::painting_surface_for_backing_store(Painting::BackingStore& backing_store)
+bool RenderingThread::paint_in_tiles(Painting::DisplayList& display_list, Painting::ScrollStateSnapshot const& scroll_state, CachedSurface& cached_surface, Gfx::IntRect const& repaint_rect)
+{
+    if (cached_surface.tile_surfaces.is_empty() || !display_list.can_be_replayed_in_parallel())
+        return false;
+
+    // NOTE: Tiles are aligned to a fixed grid, so the same tile covers the same pixels in every frame.
+    Vector<Gfx::IntRect> tiles;
+    for (int y = repaint_rect.top() / tile_size * tile_size; y < repaint_rect.bottom(); y += tile_size) {
+        for (int x = repaint_rect.left() / tile_size * tile_size; x < repaint_rect.right(); x += tile_size)
+            tiles.append(Gfx::IntRect { x, y, tile_size, tile_size }.intersected(repaint_rect));
+    }
+    if (tiles.size() < 2)
+        return false;
+
+    // NOTE: Each thread paints into its own surface wrapping the shared bitmap. Since every tile is painted with a
+    //       clip rect, threads never write to the same pixels, and commands outside of a tile are culled by the clip.
+    Atomic<size_t> next_tile_index { 0 };
+    auto paint_tiles = [&](Painting::DisplayListPlayerSkia& player, NonnullRefPtr<Gfx::PaintingSurface> const& surface) {
+        while (true) {
+            auto tile_index = next_tile_index.fetch_add(1);
+            if (tile_index >= tiles.size())
+                return;
+            player.execute(display_list, scroll_state, surface, tiles[tile_index]);
+        }
+    };
+
+    for (size_t i = 0; i < m_tile_workers.size(); ++i) {
+        auto did_start_task = m_tile_workers[i].thread->start_task([&, i]() -> ErrorOr<void> {
+            paint_tiles(*m_tile_workers[i].player, cached_surface.tile_surfaces[i]);
+            return {};
+        });
+        VERIFY(did_start_task);
+    }
+
+    paint_tiles(*m_skia_player, cached_surface.surface);
+
+    for (auto& tile_worker : m_tile_workers)
+        MUST(tile_worker.thread->wait_until_task_is_finished());
+
+    return true;
+}
+
+RenderingThread::CachedSurface& RenderingThread::painting_surface_for_backing_store(Painting::BackingStore& backing_store)
 {
     auto& bitmap = backing_store.bitmap();
     auto cached_surface = m_bitmap_to_surface.find(&bitmap);
@@ -105,11 +192,16 @@ NonnullRefPtr<Gfx::PaintingSurface> RenderingThread::painting_surface_for_backin
     }
 
     // CPU and fallback: wrap the backing store bitmap directly.
-    if (!new_surface)
+    Vector<NonnullRefPtr<Gfx::PaintingSurface>> tile_surfaces;
+    if (!new_surface) {
         new_surface = Gfx::PaintingSurface::wrap_bitmap(bitmap);
+        for (size_t i = 0; i < m_tile_workers.size(); ++i)
+            tile_surfaces.append(Gfx::PaintingSurface::wrap_bitmap(bitmap));
+    }
 
-    m_bitmap_to_surface.set(&bitmap, *new_surface);
-    return *new_surface;
+    m_bitmap_to_surface.set(&bitmap, CachedSurface { *new_surface, move(tile_surfaces) });
+    m_damage_tracker.did_create_backing_store(bitmap);
+    return m_bitmap_to_surface.find(&bitmap)->value;
 }
 
 void RenderingThread::clear_bitmap_to_surface_cache()
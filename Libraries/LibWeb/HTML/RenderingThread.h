@@ -12,8 +12,10 @@
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/Mutex.h>
 #include <LibThreading/Thread.h>
+#include <LibThreading/WorkerThread.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/BackingStoreDamageTracker.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
 
 namespace Web::HTML {
@@ -29,12 +31,20 @@ public:
     void start(DisplayListPlayerType);
     void set_skia_player(OwnPtr<Painting::DisplayListPlayerSkia>&& player) { m_skia_player = move(player); }
     void set_skia_backend_context(RefPtr<Gfx::SkiaBackendContext> context) { m_skia_backend_context = move(context); }
-    void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Painting::ScrollStateSnapshot&&, NonnullRefPtr<Painting::BackingStore>, Function<void()>&& callback);
+    // NOTE: An empty damaged rect means that the whole backing store has to be repainted.
+    void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Painting::ScrollStateSnapshot&&, NonnullRefPtr<Painting::BackingStore>, Optional<Gfx::IntRect> damaged_rect, Function<void()>&& callback);
     void clear_bitmap_to_surface_cache();
 
 private:
     void rendering_thread_loop();
-    NonnullRefPtr<Gfx::PaintingSurface> painting_surface_for_backing_store(Painting::BackingStore& backing_store);
+    struct CachedSurface {
+        NonnullRefPtr<Gfx::PaintingSurface> surface;
+
+        // Additional surfaces wrapping the same bitmap, one for each tile worker. Only CPU surfaces have these.
+        Vector<NonnullRefPtr<Gfx::PaintingSurface>> tile_surfaces;
+    };
+    CachedSurface& painting_surface_for_backing_store(Painting::BackingStore& backing_store);
+    bool paint_in_tiles(Painting::DisplayList&, Painting::ScrollStateSnapshot const&, CachedSurface&, Gfx::IntRect const& repaint_rect);
 
     Core::EventLoop& m_main_thread_event_loop;
     DisplayListPlayerType m_display_list_player_type;
@@ -43,6 +53,12 @@ private:
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
 
     RefPtr<Threading::Thread> m_thread;
+
+    struct TileWorker {
+        NonnullOwnPtr<Threading::WorkerThread<Error>> thread;
+        NonnullOwnPtr<Painting::DisplayListPlayerSkia> player;
+    };
+    Vector<TileWorker> m_tile_workers;
     Atomic<bool> m_exit { false };
     NonnullRefPtr<Core::Promise<NonnullRefPtr<Core::EventReceiver>>> m_main_thread_exit_promise;
 
@@ -50,6 +66,7 @@ private:
         NonnullRefPtr<Painting::DisplayList> display_list;
         Painting::ScrollStateSnapshot scroll_state_snapshot;
         NonnullRefPtr<Painting::BackingStore> backing_store;
+        Optional<Gfx::IntRect> damaged_rect;
         Function<void()> callback;
     };
     // NOTE: Queue will only contain multiple items in case tasks were scheduled by screenshot requests.
@@ -58,7 +75,8 @@ private:
     Threading::Mutex m_rendering_task_mutex;
     Threading::ConditionVariable m_rendering_task_ready_wake_condition { m_rendering_task_mutex };
 
-    HashMap<Gfx::Bitmap*, NonnullRefPtr<Gfx::PaintingSurface>> m_bitmap_to_surface;
+    HashMap<Gfx::Bitmap*, CachedSurface> m_bitmap_to_surface;
+    Painting::BackingStoreDamageTracker m_damage_tracker;
     bool m_needs_to_clear_bitmap_to_surface_cache { false };
 };
 
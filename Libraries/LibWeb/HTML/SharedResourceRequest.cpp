@@ -6,14 +6,19 @@
 
 #include <AK/HashTable.h>
 #include <LibGfx/Bitmap.h>
+#include <LibURL/Site.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
+#include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
+#include <LibWeb/Fetch/Infrastructure/URL.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
 #include <LibWeb/HTML/DecodedImageData.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/SharedResourceRequest.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
@@ -60,6 +65,7 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial);
     }
     visitor.visit(m_image_data);
 }
@@ -79,8 +85,33 @@ void SharedResourceRequest::set_fetch_controller(GC::Ptr<Fetch::Infrastructure::
     m_fetch_controller = move(fetch_controller);
 }
 
+static bool is_svg_image(URL::URL const& url, StringView mime_type)
+{
+    return mime_type == "image/svg+xml"sv || url.basename().ends_with(".svg"sv);
+}
+
+// NOTE: Only JPEG and PNG images can be shown before all of their data has arrived. The URL is only consulted when the
+//       response doesn't say what it contains.
+static bool can_be_decoded_progressively(URL::URL const& url, StringView mime_type)
+{
+    if (!mime_type.is_empty())
+        return mime_type.is_one_of("image/jpeg"sv, "image/png"sv);
+
+    auto basename = url.basename();
+    return basename.ends_with(".jpg"sv, CaseSensitivity::CaseInsensitive)
+        || basename.ends_with(".jpeg"sv, CaseSensitivity::CaseInsensitive)
+        || basename.ends_with(".png"sv, CaseSensitivity::CaseInsensitive);
+}
+
 void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infrastructure::Request> request)
 {
+    // OPTIMIZATION: Let the body of the response stream in, so that images can be decoded and shown while they are
+    //               still loading. Only HTTP(S) responses can be streamed at the moment. Whether the image can be
+    //               decoded progressively is decided once the headers of the response have arrived. If it can't, the
+    //               streamed body is read in full and decoded once, just like a buffered one.
+    if (Fetch::Infrastructure::is_http_or_https_scheme(request->url().scheme()))
+        request->set_buffer_policy(Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
     fetch_algorithms_input.process_response = [this, &realm, request](GC::Ref<Fetch::Infrastructure::Response> response) {
         // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
@@ -102,6 +133,11 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
             return;
         }
 
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
+        if (can_be_decoded_progressively(request->url(), mime_type) && start_incremental_decode(realm, *response->body()))
+            return;
+
         response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
     };
 
@@ -116,7 +152,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -135,18 +171,28 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = GC::create_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = GC::create_function(vm().heap(), move(on_fail));
+    if (on_partial)
+        callbacks.on_partial = GC::create_function(vm().heap(), move(on_partial));
 
     m_callbacks.append(move(callbacks));
 }
 
+// Decoded images are only shared between documents with the same top-level site, the same way the network partition
+// key keeps them from sharing anything else they fetch.
+static Optional<String> decoded_image_cache_partition(DOM::Document const& document)
+{
+    auto partition_key = Fetch::Infrastructure::determine_the_network_partition_key(document.relevant_settings_object());
+    if (partition_key.top_level_origin.is_opaque())
+        return {};
+    return URL::Site::obtain(partition_key.top_level_origin).serialize();
+}
+
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
 {
     // AD-HOC: At this point, things gets very ad-hoc.
     // FIXME: Bring this closer to spec.
 
-    bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
-
-    if (is_svg_image) {
+    if (is_svg_image(url_string, mime_type)) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
             handle_failed_fetch();
@@ -158,23 +204,86 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     }
 
     auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
-                .duration = static_cast<int>(frame.duration),
-            });
-        }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
-        strong_this->handle_successful_resource_load();
-        return {};
+        return strong_this->handle_successful_bitmap_decode(result);
     };
 
     auto handle_failed_decode = [strong_this = GC::Root(*this)](Error&) -> void {
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    // FIXME: Pass an ideal size, so that images that are shown much smaller than their natural size are decoded close
+    //        to the size they are shown at. This request is shared by every user of the URL, so that would have to be
+    //        the largest used size in device pixels among them, and the image would have to be decoded again once any
+    //        of them is shown larger than that (e.g. after resizing or zooming).
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), {}, decoded_image_cache_partition(*m_document));
+}
+
+bool SharedResourceRequest::start_incremental_decode(JS::Realm& realm, Fetch::Infrastructure::Body& body)
+{
+    auto handle_partial_bitmap_decode = [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) {
+        strong_this->handle_partial_bitmap_decode(result);
+    };
+
+    auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        return strong_this->handle_successful_bitmap_decode(result);
+    };
+
+    auto handle_failed_decode = [strong_this = GC::Root(*this)](Error&) -> void {
+        strong_this->handle_failed_fetch();
+    };
+
+    auto image_id = Web::Platform::ImageCodecPlugin::the().start_incremental_decode(move(handle_partial_bitmap_decode), move(handle_successful_bitmap_decode), move(handle_failed_decode), decoded_image_cache_partition(*m_document));
+    if (image_id.is_error())
+        return false;
+
+    auto process_body_chunk = GC::create_function(heap(), [image_id = image_id.value()](ByteBuffer chunk) {
+        Web::Platform::ImageCodecPlugin::the().append_to_incremental_decode(image_id, chunk);
+    });
+    auto process_end_of_body = GC::create_function(heap(), [image_id = image_id.value()] {
+        Web::Platform::ImageCodecPlugin::the().finish_incremental_decode(image_id);
+    });
+    auto process_body_error = GC::create_function(heap(), [this, image_id = image_id.value()](JS::Value) {
+        Web::Platform::ImageCodecPlugin::the().cancel_incremental_decode(image_id);
+        handle_failed_fetch();
+    });
+
+    body.incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
+    return true;
+}
+
+ErrorOr<void> SharedResourceRequest::handle_successful_bitmap_decode(Web::Platform::DecodedImage& result)
+{
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+    m_image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated, result.natural_size).release_value_but_fixme_should_propagate_errors();
+    handle_successful_resource_load();
+    return {};
+}
+
+void SharedResourceRequest::handle_partial_bitmap_decode(Web::Platform::DecodedImage& result)
+{
+    if (m_state != State::Fetching || result.frames.size() != 1)
+        return;
+
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append(AnimatedBitmapDecodedImageData::Frame {
+        .bitmap = Gfx::ImmutableBitmap::create(*result.frames.first().bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
+        .duration = 0,
+    });
+    auto image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false, result.natural_size);
+    if (image_data.is_error())
+        return;
+    m_image_data = image_data.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial)
+            callback.on_partial->function()();
+    }
 }
 
 void SharedResourceRequest::handle_failed_fetch()
@@ -34,7 +34,8 @@ public:
 
     void fetch_resource(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // on_partial is invoked whenever more of the image has been decoded while it is still being fetched.
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -46,6 +47,9 @@ private:
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    bool start_incremental_decode(JS::Realm&, Fetch::Infrastructure::Body&);
+    ErrorOr<void> handle_successful_bitmap_decode(Platform::DecodedImage&);
+    void handle_partial_bitmap_decode(Platform::DecodedImage&);
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -63,6 +67,7 @@ private:
     struct Callbacks {
         GC::Ptr<GC::Function<void()>> on_finish;
         GC::Ptr<GC::Function<void()>> on_fail;
+        GC::Ptr<GC::Function<void()>> on_partial;
     };
     Vector<Callbacks> m_callbacks;
 
@@ -1424,10 +1424,22 @@ RefPtr<Painting::DisplayList> TraversableNavigable::record_display_list(DevicePi
     return document->record_display_list(paint_config);
 }
 
-void TraversableNavigable::start_display_list_rendering(NonnullRefPtr<Painting::DisplayList> display_list, NonnullRefPtr<Painting::BackingStore> backing_store, Function<void()>&& callback)
+DevicePixelRect TraversableNavigable::take_damaged_rect(DevicePixelSize viewport_size)
+{
+    DevicePixelRect viewport_rect { {}, viewport_size };
+    auto damaged_rect = m_whole_viewport_is_damaged ? viewport_rect : m_damaged_rect.intersected(viewport_rect);
+    m_damaged_rect = {};
+    m_whole_viewport_is_damaged = false;
+    return damaged_rect;
+}
+
+void TraversableNavigable::start_display_list_rendering(NonnullRefPtr<Painting::DisplayList> display_list, NonnullRefPtr<Painting::BackingStore> backing_store, Optional<DevicePixelRect> damaged_rect, Function<void()>&& callback)
 {
     auto scroll_state_snapshot = active_document()->paintable()->scroll_state().snapshot();
-    m_rendering_thread.enqueue_rendering_task(move(display_list), move(scroll_state_snapshot), move(backing_store), move(callback));
+    Optional<Gfx::IntRect> damaged_int_rect;
+    if (damaged_rect.has_value())
+        damaged_int_rect = damaged_rect->to_type<int>();
+    m_rendering_thread.enqueue_rendering_task(move(display_list), move(scroll_state_snapshot), move(backing_store), damaged_int_rect, move(callback));
 }
 
 }
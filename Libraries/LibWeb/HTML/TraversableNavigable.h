@@ -101,7 +101,8 @@ public:
     [[nodiscard]] GC::Ptr<DOM::Node> currently_focused_area();
 
     RefPtr<Painting::DisplayList> record_display_list(DevicePixelRect const&, PaintOptions);
-    void start_display_list_rendering(NonnullRefPtr<Painting::DisplayList>, NonnullRefPtr<Painting::BackingStore>, Function<void()>&& callback);
+    // NOTE: If a damaged rect is given, only that part of the backing store is repainted.
+    void start_display_list_rendering(NonnullRefPtr<Painting::DisplayList>, NonnullRefPtr<Painting::BackingStore>, Optional<DevicePixelRect> damaged_rect, Function<void()>&& callback);
 
     enum class CheckIfUnloadingIsCanceledResult {
         CanceledByBeforeUnload,
@@ -118,7 +119,20 @@ public:
     void set_viewport_size(CSSPixelSize) override;
 
     bool needs_repaint() const { return m_needs_repaint; }
-    void set_needs_repaint() { m_needs_repaint = true; }
+    void set_needs_repaint()
+    {
+        m_needs_repaint = true;
+        m_whole_viewport_is_damaged = true;
+    }
+    void set_needs_repaint(DevicePixelRect const& damaged_rect)
+    {
+        m_needs_repaint = true;
+        m_damaged_rect.unite(damaged_rect);
+    }
+    void mark_whole_viewport_as_damaged() { m_whole_viewport_is_damaged = true; }
+
+    // Returns the part of the viewport that changed since the last frame, and starts collecting damage for the next one.
+    DevicePixelRect take_damaged_rect(DevicePixelSize viewport_size);
 
 private:
     TraversableNavigable(GC::Ref<Page>);
@@ -173,6 +187,10 @@ private:
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
 
     bool m_needs_repaint { true };
+
+    // Damage in viewport-relative device pixels, collected since the last frame was painted.
+    DevicePixelRect m_damaged_rect;
+    bool m_whole_viewport_is_damaged { true };
 };
 
 struct BrowsingContextAndDocument {
@@ -68,6 +68,86 @@ GC::Ptr<Painting::Paintable> Box::create_paintable() const
     return Painting::PaintableBox::create(*this);
 }
 
+static bool is_content_independent_size(CSS::Size const& size)
+{
+    return size.is_length();
+}
+
+static bool is_content_independent_min_or_max_size(CSS::Size const& size)
+{
+    return size.is_auto() || size.is_none() || size.is_length();
+}
+
+bool Box::is_layout_boundary() const
+{
+    if (is_viewport() || is_anonymous() || !dom_node())
+        return false;
+
+    // NOTE: We reuse the size and position from the previous layout, so there has to be one.
+    auto const* paintable_box = this->paintable_box();
+    if (!paintable_box || !paintable_box->parent())
+        return false;
+
+    // The box has to establish a block formatting context, so that nothing inside of it (margins, floats) can escape.
+    // NOTE: List items and fieldsets are excluded, since their parent formatting context lays out parts of them.
+    if (!is<BlockContainer>(*this) || is_list_item_box() || is_fieldset_box())
+        return false;
+    if (FormattingContext::formatting_context_type_created_by_box(*this) != FormattingContext::Type::Block)
+        return false;
+
+    // Its contents must not overflow into the scrollable overflow of its ancestors.
+    auto const& computed_values = this->computed_values();
+    if (computed_values.overflow_x() == CSS::Overflow::Visible || computed_values.overflow_y() == CSS::Overflow::Visible)
+        return false;
+
+    // Its size must not depend on its contents.
+    if (!has_size_containment()) {
+        if (!is_content_independent_size(computed_values.width()) || !is_content_independent_size(computed_values.height()))
+            return false;
+        if (!is_content_independent_min_or_max_size(computed_values.min_width()) || !is_content_independent_min_or_max_size(computed_values.max_width()))
+            return false;
+        if (!is_content_independent_min_or_max_size(computed_values.min_height()) || !is_content_independent_min_or_max_size(computed_values.max_height()))
+            return false;
+    }
+
+    // It must be an in-flow block-level box in a block formatting context, so that laying it out by itself ends up
+    // in the same place as laying out its parent would.
+    if (!display().is_block_outside() || !is_in_flow() || is_flex_item() || is_grid_item())
+        return false;
+    if (computed_values.position() != CSS::Positioning::Static && computed_values.position() != CSS::Positioning::Relative)
+        return false;
+    auto const* parent = this->parent();
+    if (!parent || !is<BlockContainer>(*parent) || parent->children_are_inline())
+        return false;
+    if (!parent->display().is_flow_inside() && !parent->display().is_flow_root_inside())
+        return false;
+
+    // Finally, nothing inside of it may be positioned relative to a box outside of it.
+    return !has_descendant_with_containing_block_outside_of_this();
+}
+
+bool Box::has_descendant_with_containing_block_outside_of_this() const
+{
+    // OPTIMIZATION: This walks the whole subtree, so we only do it again after the layout tree or its styles changed.
+    auto generation = document().layout_subtree_cache_generation();
+    if (m_cached_has_descendant_with_containing_block_outside_of_this_generation == generation)
+        return m_cached_has_descendant_with_containing_block_outside_of_this;
+
+    bool result = false;
+    for_each_in_subtree([&](Node const& node) {
+        auto const* containing_block = node.containing_block();
+        if (!containing_block || !is_inclusive_ancestor_of(*containing_block)) {
+            result = true;
+            return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+
+    m_cached_has_descendant_with_containing_block_outside_of_this = result;
+    m_cached_has_descendant_with_containing_block_outside_of_this_generation = generation;
+    return result;
+}
+
 Painting::PaintableBox* Box::paintable_box()
 {
     return static_cast<Painting::PaintableBox*>(Node::first_paintable());
@@ -68,6 +68,11 @@ public:
     }
     void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes.clear(); }
 
+    // A layout boundary is a box whose size and position can't be affected by anything inside of it. When only things
+    // inside of it need a layout update, it can be laid out again by itself, using its size from the previous layout.
+    // NOTE: This relies on the containing blocks of the boxes inside of it being up to date.
+    bool is_layout_boundary() const;
+
 protected:
     Box(DOM::Document&, DOM::Node*, GC::Ref<CSS::ComputedProperties>);
     Box(DOM::Document&, DOM::Node*, NonnullOwnPtr<CSS::ComputedValues>);
@@ -82,6 +87,10 @@ private:
     Vector<GC::Ref<Node>> m_contained_abspos_children;
 
     OwnPtr<IntrinsicSizes> mutable m_cached_intrinsic_sizes;
+
+    bool has_descendant_with_containing_block_outside_of_this() const;
+    mutable bool m_cached_has_descendant_with_containing_block_outside_of_this { false };
+    mutable u64 m_cached_has_descendant_with_containing_block_outside_of_this_generation { 0 };
 };
 
 template<>
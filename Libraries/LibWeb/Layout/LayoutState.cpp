@@ -193,6 +193,21 @@ static void build_paint_tree(Node& node, Painting::Paintable* parent_paintable =
 
 void LayoutState::commit(Box& root)
 {
+    // NOTE: When only a layout boundary was laid out, we also have used values for its containing blocks. Those keep
+    //       the paintables from the previous layout, so we set their used values aside until we are done here.
+    Vector<NonnullOwnPtr<UsedValues>> used_values_outside_of_root;
+    GC::Ptr<Painting::Paintable> old_root_paintable;
+    if (!root.is_viewport()) {
+        used_values_per_layout_node.remove_all_matching([&](auto const& node, auto& used_values) {
+            if (root.is_inclusive_ancestor_of(*node))
+                return false;
+            used_values_outside_of_root.append(move(used_values));
+            return true;
+        });
+        old_root_paintable = root.first_paintable();
+        VERIFY(old_root_paintable && old_root_paintable->parent());
+    }
+
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
@@ -203,7 +218,11 @@ void LayoutState::commit(Box& root)
 
     HashTable<Layout::InlineNode*> inline_nodes;
 
-    root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+    // NOTE: The viewport's DOM node is the document, so this covers the whole document for a full layout.
+    VERIFY(root.dom_node());
+    root.dom_node()->for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+        if (old_root_paintable && node.layout_node() && !root.is_inclusive_ancestor_of(*node.layout_node()))
+            return TraversalDecision::Continue;
         node.clear_paintable();
         if (node.layout_node() && is<InlineNode>(node.layout_node())) {
             // Inline nodes might have a continuation chain; add all inline nodes that are part of it.
@@ -352,6 +371,9 @@ void LayoutState::commit(Box& root)
 
     build_paint_tree(root);
 
+    if (old_root_paintable)
+        old_root_paintable->parent()->replace_child(*root.first_paintable(), *old_root_paintable);
+
     resolve_relative_positions();
 
     // Measure size of paintables created for inline nodes.
@@ -365,6 +365,9 @@ static CSSPixels snap_a_length_as_a_border_width(double device_pixels_per_css_pi
 
 void NodeWithStyle::apply_style(CSS::ComputedProperties const& computed_style)
 {
+    // NOTE: A change in style anywhere can change the containing block of boxes, which layout boxes cache facts about.
+    document().invalidate_layout_subtree_caches();
+
     auto& computed_values = mutable_computed_values();
 
     // NOTE: color-scheme must be set first to ensure system colors can be resolved correctly.
@@ -1423,7 +1426,7 @@ void NodeWithStyleAndBoxModelMetrics::visit_edges(Cell::Visitor& visitor)
 
 void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
 {
-    if (m_needs_layout_update)
+    if (m_needs_layout_update_of_self)
         return;
 
     if constexpr (UPDATE_LAYOUT_DEBUG) {
@@ -1434,12 +1437,14 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
     }
 
     m_needs_layout_update = true;
+    m_needs_layout_update_of_self = true;
 
     // Mark any anonymous children generated by this node for layout update.
     // NOTE: if this node generated an anonymous parent, all ancestors are indiscriminately marked below.
     for_each_child_of_type<Box>([&](Box& child) {
         if (child.is_anonymous() && !is<TableWrapper>(child)) {
             child.m_needs_layout_update = true;
+            child.m_needs_layout_update_of_self = true;
         }
         return IterationDecision::Continue;
     });
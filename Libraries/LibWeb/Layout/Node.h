@@ -46,8 +46,15 @@ public:
     DOM::Element* pseudo_element_generator();
 
     bool needs_layout_update() const { return m_needs_layout_update; }
+    // NOTE: Unlike needs_layout_update(), this is not set on ancestors that only need a layout update on behalf of one
+    //       of their descendants.
+    bool needs_layout_update_of_self() const { return m_needs_layout_update_of_self; }
     void set_needs_layout_update(DOM::SetNeedsLayoutReason);
-    void reset_needs_layout_update() { m_needs_layout_update = false; }
+    void reset_needs_layout_update()
+    {
+        m_needs_layout_update = false;
+        m_needs_layout_update_of_self = false;
+    }
 
     bool is_generated() const { return m_generated_for.has_value(); }
     bool is_generated_for_before_pseudo_element() const { return m_generated_for == CSS::GeneratedPseudoElement::Before; }
@@ -227,6 +234,7 @@ private:
     bool m_has_been_wrapped_in_table_wrapper { false };
 
     bool m_needs_layout_update { false };
+    bool m_needs_layout_update_of_self { false };
 
     Optional<CSS::GeneratedPseudoElement> m_generated_for {};
 
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/TemporaryChange.h>
 #include <LibWeb/CSS/ComputedProperties.h>
@@ -622,6 +623,10 @@ void TreeBuilder::update_layout_tree(DOM::Node& dom_node, TreeBuilder::Context&
         if (auto node_with_metrics = as_if<NodeWithStyleAndBoxModelMetrics>(*layout_node);
             node_with_metrics && node_with_metrics->should_create_inline_continuation())
             restructure_block_node_in_inline_parent(*node_with_metrics);
+
+        // NOTE: This is the root of a subtree that was built again inside of an existing layout tree.
+        if (must_create_subtree == MustCreateSubtree::No && !dom_node.is_document())
+            m_rebuilt_subtree_roots.append(*layout_node);
     }
 
     // https://www.w3.org/TR/css-contain-2/#containment-style
@@ -760,12 +765,46 @@ GC::Ptr<Layout::Node> TreeBuilder::build(DOM::Node& dom_node)
 
     dom_node.document().style_computer().reset_ancestor_filter();
 
+    GC::Ptr<Layout::Node> old_layout_root = dom_node.layout_node();
+
     Context context;
     m_quote_nesting_level = 0;
+    m_rebuilt_subtree_roots.clear();
     update_layout_tree(dom_node, context, MustCreateSubtree::No);
 
-    if (auto* root = dom_node.document().layout_node())
+    auto* root = dom_node.document().layout_node();
+    if (!root)
+        return m_layout_root;
+
+    if (root != old_layout_root) {
         fixup_tables(*root);
+        return m_layout_root;
+    }
+
+    // OPTIMIZATION: Only the parts of the tree that were built again can need anonymous table boxes, so we limit the
+    //               fixups to the parents of the rebuilt subtrees. Their parent is included, since a rebuilt node may
+    //               need to be wrapped together with its siblings.
+    HashTable<NodeWithStyle*> parents_of_rebuilt_subtrees;
+    for (auto& rebuilt_subtree_root : m_rebuilt_subtree_roots) {
+        if (auto* parent = rebuilt_subtree_root->parent())
+            parents_of_rebuilt_subtrees.set(static_cast<NodeWithStyle*>(parent));
+    }
+    for (auto* parent : parents_of_rebuilt_subtrees) {
+        bool is_inside_other_fixup_root = false;
+        for (auto* ancestor = parent->parent(); ancestor; ancestor = ancestor->parent()) {
+            if (parents_of_rebuilt_subtrees.contains(static_cast<NodeWithStyle*>(ancestor))) {
+                is_inside_other_fixup_root = true;
+                break;
+            }
+        }
+        if (!is_inside_other_fixup_root)
+            fixup_tables(*parent);
+    }
+
+    // NOTE: We do this after the fixups, so that any anonymous boxes they wrapped around the rebuilt subtrees are marked
+    //       as well.
+    for (auto& rebuilt_subtree_root : m_rebuilt_subtree_roots)
+        rebuilt_subtree_root->set_needs_layout_update(DOM::SetNeedsLayoutReason::LayoutTreeUpdate);
 
     return m_layout_root;
 }
@@ -63,6 +63,7 @@ private:
 
     GC::Ptr<Layout::Node> m_layout_root;
     Vector<GC::Ref<Layout::NodeWithStyle>> m_ancestor_stack;
+    Vector<GC::Ref<Layout::Node>> m_rebuilt_subtree_roots;
 
     u32 m_quote_nesting_level { 0 };
 };
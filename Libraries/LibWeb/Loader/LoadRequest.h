@@ -46,6 +46,11 @@ public:
     GC::Ptr<Page> page() const { return m_page.ptr(); }
     void set_page(Page& page) { m_page = page; }
 
+    // https://fetch.spec.whatwg.org/#determine-the-http-cache-partition
+    // Identifies the partition of RequestServer's HTTP cache that this request may be served from and stored in.
+    Optional<ByteString> const& http_cache_partition() const { return m_http_cache_partition; }
+    void set_http_cache_partition(Optional<ByteString> partition) { m_http_cache_partition = move(partition); }
+
     unsigned hash() const
     {
         auto body_hash = string_hash((char const*)m_body.data(), m_body.size());
@@ -82,6 +87,7 @@ private:
     ByteBuffer m_body;
     Core::ElapsedTimer m_load_timer;
     GC::Root<Page> m_page;
+    Optional<ByteString> m_http_cache_partition;
     bool m_main_resource { false };
 };
 
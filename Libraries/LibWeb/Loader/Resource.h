@@ -66,7 +66,7 @@ public:
 
     void for_each_client(Function<void(ResourceClient&)>);
 
-    void did_load(Badge<ResourceLoader>, ReadonlyBytes data, HTTP::HeaderMap const&, Optional<u32> status_code);
+    void did_load(Badge<ResourceLoader>, ByteBuffer data, HTTP::HeaderMap const&, Optional<u32> status_code);
     void did_fail(Badge<ResourceLoader>, ByteString const& error, ReadonlyBytes data, HTTP::HeaderMap const&, Optional<u32> status_code);
 
 protected:
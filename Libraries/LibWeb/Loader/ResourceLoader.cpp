@@ -110,8 +110,8 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest&
 
     load(
         request,
-        GC::create_function(m_heap, [resource](ReadonlyBytes data, Requests::RequestTimingInfo const&, HTTP::HeaderMap const& headers, Optional<u32> status_code, Optional<String> const&) {
-            resource->did_load({}, data, headers, status_code);
+        GC::create_function(m_heap, [resource](ByteBuffer data, Requests::RequestTimingInfo const&, HTTP::HeaderMap const& headers, Optional<u32> status_code, Optional<String> const&) {
+            resource->did_load({}, move(data), headers, status_code);
         }),
         GC::create_function(m_heap, [resource](ByteString const& error, Requests::RequestTimingInfo const&, Optional<u32> status_code, Optional<String> const&, ReadonlyBytes data, HTTP::HeaderMap const& headers) {
             resource->did_fail({}, error, data, headers, status_code);
@@ -236,7 +236,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
         log_success(request);
         HTTP::HeaderMap response_headers;
         response_headers.set("Content-Type"sv, "text/html"sv);
-        success_callback->function()(maybe_response.release_value().bytes(), fixme_implement_timing_info, response_headers, {}, {});
+        success_callback->function()(MUST(ByteBuffer::copy(maybe_response.value().bytes())), fixme_implement_timing_info, response_headers, {}, {});
     };
 
     if (url.scheme() == "about") {
@@ -253,7 +253,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
 
         // About version page
         if (serialized_path == "version") {
-            success_callback->function()(MUST(load_about_version_page()).bytes(), fixme_implement_timing_info, response_headers, {}, {});
+            success_callback->function()(MUST(ByteBuffer::copy(MUST(load_about_version_page()).bytes())), fixme_implement_timing_info, response_headers, {}, {});
             return;
         }
 
@@ -264,14 +264,13 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
         if (about_directory->children().contains_slow(target_file.view())) {
             auto resource = Core::Resource::load_from_uri(ByteString::formatted("resource://ladybird/about-pages/{}", target_file));
             if (!resource.is_error()) {
-                auto data = resource.value()->data();
-                success_callback->function()(data, fixme_implement_timing_info, response_headers, {}, {});
+                success_callback->function()(resource.value()->clone_data(), fixme_implement_timing_info, response_headers, {}, {});
                 return;
             }
         }
 
         Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(m_heap, [success_callback, response_headers = move(response_headers), fixme_implement_timing_info = move(fixme_implement_timing_info)] {
-            success_callback->function()(ByteString::empty().to_byte_buffer(), fixme_implement_timing_info, response_headers, {}, {});
+            success_callback->function()({}, fixme_implement_timing_info, response_headers, {}, {});
         }));
         return;
     }
@@ -295,11 +294,11 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
 
         log_success(request);
 
-        Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(m_heap, [data = move(data_url.body), response_headers = move(response_headers), success_callback] {
+        Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(m_heap, [data = move(data_url.body), response_headers = move(response_headers), success_callback] mutable {
             // FIXME: Implement timing info for data requests.
             Requests::RequestTimingInfo fixme_implement_timing_info {};
 
-            success_callback->function()(data, fixme_implement_timing_info, response_headers, {}, {});
+            success_callback->function()(move(data), fixme_implement_timing_info, response_headers, {}, {});
         }));
         return;
     }
@@ -321,14 +320,14 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
             return;
         }
 
-        auto data = resource.value()->data();
+        auto data = resource.value()->clone_data();
         auto response_headers = response_headers_for_file(url.file_path(), resource.value()->modified_time());
 
         // FIXME: Implement timing info for resource requests.
         Requests::RequestTimingInfo fixme_implement_timing_info {};
 
         log_success(request);
-        success_callback->function()(data, fixme_implement_timing_info, response_headers, {}, {});
+        success_callback->function()(move(data), fixme_implement_timing_info, response_headers, {}, {});
 
         return;
     }
@@ -394,7 +393,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
             Requests::RequestTimingInfo fixme_implement_timing_info {};
 
             log_success(request);
-            success_callback->function()(data, fixme_implement_timing_info, response_headers, {}, {});
+            success_callback->function()(move(data), fixme_implement_timing_info, response_headers, {}, {});
         });
 
         page->client().request_file(move(file_request));
@@ -425,7 +424,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
             timer->start();
         }
 
-        auto on_buffered_request_finished = [this, success_callback, error_callback, request, &protocol_request = *protocol_request](auto, auto const& timing_info, auto const& network_error, auto& response_headers, auto status_code, auto const& reason_phrase, ReadonlyBytes payload) mutable {
+        auto on_buffered_request_finished = [this, success_callback, error_callback, request, &protocol_request = *protocol_request](auto, auto const& timing_info, auto const& network_error, auto& response_headers, auto status_code, auto const& reason_phrase, ByteBuffer payload) mutable {
             handle_network_response_headers(request, response_headers);
 
             // NOTE: We finish the network request *after* invoking callbacks, otherwise a nested
@@ -457,7 +456,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
             }
 
             log_success(request);
-            success_callback->function()(payload, timing_info, response_headers, status_code, reason_phrase);
+            success_callback->function()(move(payload), timing_info, response_headers, status_code, reason_phrase);
         };
 
         protocol_request->set_buffered_request_finished_callback(move(on_buffered_request_finished));
@@ -532,7 +531,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
     if (!headers.contains("User-Agent"))
         headers.set("User-Agent", m_user_agent.to_byte_string());
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy, request.http_cache_partition());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Painting/BackingStoreDamageTracker.h>
+
+namespace Web::Painting {
+
+void BackingStoreDamageTracker::did_create_backing_store(Gfx::Bitmap const& bitmap)
+{
+    m_pending_damage.set(&bitmap, {});
+}
+
+void BackingStoreDamageTracker::did_forget_all_backing_stores()
+{
+    m_pending_damage.clear();
+}
+
+Optional<Gfx::IntRect> BackingStoreDamageTracker::rect_to_repaint(Gfx::Bitmap const& bitmap, Optional<Gfx::IntRect> const& frame_damage) const
+{
+    if (!frame_damage.has_value())
+        return {};
+    auto pending_damage = m_pending_damage.get(&bitmap);
+    if (!pending_damage.has_value() || !pending_damage->has_value())
+        return {};
+
+    Gfx::IntRect bitmap_rect { {}, bitmap.size() };
+    auto rect = frame_damage->united(**pending_damage).intersected(bitmap_rect);
+    if (rect == bitmap_rect)
+        return {};
+    return rect;
+}
+
+void BackingStoreDamageTracker::did_paint_frame(Gfx::Bitmap const& bitmap, Gfx::IntRect const& frame_damage)
+{
+    for (auto& [other_bitmap, pending_damage] : m_pending_damage) {
+        if (other_bitmap == &bitmap || !pending_damage.has_value())
+            continue;
+        pending_damage->unite(frame_damage);
+    }
+    m_pending_damage.set(&bitmap, Gfx::IntRect {});
+}
+
+void BackingStoreDamageTracker::add_damage(Gfx::Bitmap const& bitmap, Gfx::IntRect const& rect)
+{
+    auto pending_damage = m_pending_damage.find(&bitmap);
+    if (pending_damage == m_pending_damage.end() || !pending_damage->value.has_value())
+        return;
+    pending_damage->value->unite(rect);
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Rect.h>
+
+namespace Web::Painting {
+
+// Frames are painted into a few backing stores in turn, each of which still contains the frame that was last painted
+// into it. This keeps track of what changed in each of them since then, so only that has to be repainted.
+class BackingStoreDamageTracker {
+public:
+    // The contents of a new backing store are unknown, so the first frame painted into it repaints all of it.
+    void did_create_backing_store(Gfx::Bitmap const&);
+    void did_forget_all_backing_stores();
+
+    // Returns the part of the backing store that has to be repainted for a frame with the given damage, or an empty
+    // value if all of it has to be repainted. Frames without damage (e.g. screenshots) repaint everything.
+    Optional<Gfx::IntRect> rect_to_repaint(Gfx::Bitmap const&, Optional<Gfx::IntRect> const& frame_damage) const;
+
+    // The other backing stores are now behind by the damage of this frame.
+    void did_paint_frame(Gfx::Bitmap const&, Gfx::IntRect const& frame_damage);
+
+    // Makes sure the rect is repainted the next time a frame is painted into the backing store.
+    void add_damage(Gfx::Bitmap const&, Gfx::IntRect const&);
+
+private:
+    // Damage from frames that were painted into other backing stores since each backing store was last painted.
+    // An empty value means that the contents of the backing store are unknown.
+    HashMap<Gfx::Bitmap const*, Optional<Gfx::IntRect>> m_pending_damage;
+};
+
+}
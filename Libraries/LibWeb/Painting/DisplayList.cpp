@@ -4,13 +4,21 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Painting/DisplayList.h>
 
 namespace Web::Painting {
 
-void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
+static bool command_can_be_replayed_in_parallel(Command const& command)
 {
-    m_commands.append({ scroll_frame_id, move(command) });
+    return command.visit(
+        // NOTE: Backdrop filters read the pixels around them from the target surface, which other threads may be painting into.
+        [](ApplyBackdropFilter const&) { return false; },
+        // NOTE: Taking a snapshot of a painting surface (e.g. a canvas) is not thread-safe.
+        [](DrawPaintingSurface const&) { return false; },
+        [](PaintNestedDisplayList const& command) { return !command.display_list || command.display_list->can_be_replayed_in_parallel(); },
+        [](AddMask const& command) { return !command.display_list || command.display_list->can_be_replayed_in_parallel(); },
+        [](auto const&) { return true; });
 }
 
 static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
@@ -35,18 +43,180 @@ static bool command_is_clip_or_mask(Command const& command)
         });
 }
 
-void DisplayListPlayer::execute(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface)
+static constexpr size_t min_commands_per_culling_range = 8;
+static constexpr size_t max_commands_per_culling_range = 64;
+
+enum class CullingCommandKind {
+    // Saves the painter state, to be restored by a matching closer.
+    Opener,
+    Closer,
+    // Changes the painter state until the next closer.
+    StateChange,
+    Paint,
+};
+
+static CullingCommandKind culling_kind_of_command(Command const& command)
+{
+    if (command.has<Save>() || command.has<SaveLayer>() || command.has<PushStackingContext>() || command.has<ApplyOpacity>() || command.has<ApplyCompositeAndBlendingOperator>() || command.has<ApplyFilter>())
+        return CullingCommandKind::Opener;
+    if (command.has<Restore>() || command.has<PopStackingContext>())
+        return CullingCommandKind::Closer;
+    if (command.has<Translate>() || command.has<ApplyTransform>() || command.has<ApplyMaskBitmap>() || command_is_clip_or_mask(command))
+        return CullingCommandKind::StateChange;
+    return CullingCommandKind::Paint;
+}
+
+// Whether the bounds of the commands after an opener can still be compared against the clip from before it.
+static bool opener_preserves_culling_bounds(Command const& command)
+{
+    if (command.has<PushStackingContext>())
+        return Gfx::extract_2d_affine_transform(command.get<PushStackingContext>().transform.matrix).is_identity();
+    // NOTE: Filters such as blurs may paint content from outside of the clip into it.
+    if (command.has<ApplyFilter>())
+        return false;
+    return true;
+}
+
+static Optional<Gfx::IntRect> command_culling_rect(Command const& command)
+{
+    return command.visit(
+        // NOTE: Glyphs may extend beyond the rect of their text fragment.
+        [](DrawGlyphRun const& command) -> Optional<Gfx::IntRect> {
+            auto overhang = command.rect.height();
+            return command.rect.inflated(overhang, overhang, overhang, overhang);
+        },
+        // NOTE: Repeated bitmaps fill the current clip, which the recorder has restricted to the clip rect.
+        [](DrawRepeatedImmutableBitmap const& command) -> Optional<Gfx::IntRect> { return command.clip_rect; },
+        [](DrawLine const& command) -> Optional<Gfx::IntRect> {
+            return Gfx::IntRect::from_two_points(command.from, command.to).inflated(command.thickness * 2, command.thickness * 2);
+        },
+        [](DrawTriangleWave const& command) -> Optional<Gfx::IntRect> {
+            auto extent = (command.amplitude + command.thickness) * 2;
+            return Gfx::IntRect::from_two_points(command.p1, command.p2).inflated(extent, extent);
+        },
+        [](PaintScrollBar const& command) -> Optional<Gfx::IntRect> { return command.gutter_rect; },
+        [](auto const& command) -> Optional<Gfx::IntRect> {
+            if constexpr (requires { command.bounding_rect(); })
+                return command.bounding_rect();
+            else
+                return {};
+        });
+}
+
+static void add_culling_bounds(Vector<DisplayList::CullingRange::Bounds, 1>& bounds, Optional<i32> scroll_frame_id, Gfx::IntRect const& rect)
+{
+    for (auto& existing_bounds : bounds) {
+        if (existing_bounds.scroll_frame_id == scroll_frame_id) {
+            existing_bounds.rect.unite(rect);
+            return;
+        }
+    }
+    bounds.append({ scroll_frame_id, rect });
+}
+
+void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
+{
+    if (m_can_be_replayed_in_parallel && !command_can_be_replayed_in_parallel(command))
+        m_can_be_replayed_in_parallel = false;
+    update_culling_index(command, scroll_frame_id, m_commands.size());
+    m_commands.append({ scroll_frame_id, move(command) });
+}
+
+// OPTIMIZATION: While commands are appended, we split them into ranges that leave the painter state unchanged, and
+//               remember what each range paints. During replay, a range whose bounds are all clipped out is skipped
+//               as a whole, so long pages don't have to visit every off-screen command on every frame.
+//               Each open Save/Restore or stacking context pair gets its own scope, so ranges nest like the
+//               painter state does: a range that is partially visible may still contain ranges that are not.
+void DisplayList::update_culling_index(Command const& command, Optional<i32> scroll_frame_id, size_t command_index)
+{
+    auto& scope = m_open_culling_scopes.last();
+    switch (culling_kind_of_command(command)) {
+    case CullingCommandKind::Opener: {
+        if (!opener_preserves_culling_bounds(command)) {
+            scope.segment_is_cullable = false;
+            scope.scope_is_cullable = false;
+        }
+        // NOTE: Filters may paint content from outside of the clip into it, so nothing inside of them may be culled.
+        bool contents_may_be_culled = scope.contents_may_be_culled && !command.has<ApplyFilter>();
+        m_open_culling_scopes.append({
+            .segment_start = command_index + 1,
+            .segment_is_cullable = contents_may_be_culled,
+            .scope_is_cullable = contents_may_be_culled,
+            .contents_may_be_culled = contents_may_be_culled,
+        });
+        return;
+    }
+    case CullingCommandKind::Closer: {
+        if (m_open_culling_scopes.size() == 1) {
+            // NOTE: This restores a state from before this display list, so no range may contain it.
+            end_culling_segment(scope, command_index);
+            scope.segment_start = command_index + 1;
+            return;
+        }
+        auto child_scope = m_open_culling_scopes.take_last();
+        end_culling_segment(child_scope, command_index);
+        auto& parent_scope = m_open_culling_scopes.last();
+        for (auto const& bounds : child_scope.scope_bounds)
+            add_culling_bounds(parent_scope.segment_bounds, bounds.scroll_frame_id, bounds.rect);
+        if (!child_scope.scope_is_cullable) {
+            parent_scope.segment_is_cullable = false;
+            parent_scope.scope_is_cullable = false;
+        }
+        break;
+    }
+    case CullingCommandKind::StateChange:
+        // NOTE: Commands after a transform are painted in different coordinates than the ones before it.
+        if (command.has<Translate>() || command.has<ApplyTransform>())
+            scope.scope_is_cullable = false;
+        end_culling_segment(scope, command_index);
+        scope.segment_start = command_index + 1;
+        return;
+    case CullingCommandKind::Paint:
+        if (auto rect = command_culling_rect(command); rect.has_value()) {
+            add_culling_bounds(scope.segment_bounds, scroll_frame_id, *rect);
+        } else {
+            scope.segment_is_cullable = false;
+            scope.scope_is_cullable = false;
+        }
+        break;
+    }
+
+    auto& current_scope = m_open_culling_scopes.last();
+    if (command_index + 1 - current_scope.segment_start >= max_commands_per_culling_range) {
+        end_culling_segment(current_scope, command_index + 1);
+        current_scope.segment_start = command_index + 1;
+    }
+}
+
+void DisplayList::end_culling_segment(CullingScope& scope, size_t end)
+{
+    auto start = scope.segment_start;
+    if (scope.segment_is_cullable && end - start >= min_commands_per_culling_range) {
+        // NOTE: Ranges of outer scopes end after the ranges nested in them, so insert them in front of those.
+        auto insertion_index = m_culling_ranges.size();
+        while (insertion_index > 0 && m_culling_ranges[insertion_index - 1].start > start)
+            --insertion_index;
+        m_culling_ranges.insert(insertion_index, CullingRange { start, end, scope.segment_bounds });
+    }
+
+    for (auto const& bounds : scope.segment_bounds)
+        add_culling_bounds(scope.scope_bounds, bounds.scroll_frame_id, bounds.rect);
+    scope.segment_bounds.clear();
+    scope.segment_is_cullable = scope.contents_may_be_culled;
+}
+
+void DisplayListPlayer::execute(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface, Optional<Gfx::IntRect> damaged_rect)
 {
     if (surface) {
         surface->lock_context();
     }
-    execute_impl(display_list, scroll_state, surface);
+    execute_impl(display_list, scroll_state, surface, damaged_rect);
     if (surface) {
         surface->unlock_context();
     }
 }
 
-void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface)
+void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface, Optional<Gfx::IntRect> damaged_rect)
 {
     if (surface)
         m_surfaces.append(*surface);
@@ -56,11 +226,46 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
     };
 
     auto const& commands = display_list.commands();
+    auto const& culling_ranges = display_list.culling_ranges();
     auto device_pixels_per_css_pixel = display_list.device_pixels_per_css_pixel();
 
+    auto scroll_offset_for_frame = [&](i32 scroll_frame_id) {
+        auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id);
+        return cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
+    };
+
+    auto culling_range_would_be_fully_clipped = [&](DisplayList::CullingRange const& culling_range) {
+        for (auto const& bounds : culling_range.bounds) {
+            auto rect = bounds.rect;
+            if (bounds.scroll_frame_id.has_value())
+                rect.translate_by(scroll_offset_for_frame(bounds.scroll_frame_id.value()));
+            if (!rect.is_empty() && !would_be_fully_clipped_by_painter(rect))
+                return false;
+        }
+        return true;
+    };
+    size_t next_culling_range_index = 0;
+
     VERIFY(!m_surfaces.is_empty());
 
+    // OPTIMIZATION: Clipping to the damaged rect makes every command that lies entirely outside of it fail the
+    //               would_be_fully_clipped_by_painter() check below, so only commands touching damaged pixels are replayed.
+    if (damaged_rect.has_value()) {
+        save({});
+        add_clip_rect({ *damaged_rect });
+    }
+
     for (size_t command_index = 0; command_index < commands.size(); command_index++) {
+        while (next_culling_range_index < culling_ranges.size() && culling_ranges[next_culling_range_index].start < command_index)
+            next_culling_range_index++;
+        if (next_culling_range_index < culling_ranges.size() && culling_ranges[next_culling_range_index].start == command_index) {
+            auto const& culling_range = culling_ranges[next_culling_range_index++];
+            if (culling_range_would_be_fully_clipped(culling_range)) {
+                command_index = culling_range.end - 1;
+                continue;
+            }
+        }
+
         auto scroll_frame_id = commands[command_index].scroll_frame_id;
         auto command = commands[command_index].command;
 
@@ -77,8 +282,7 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         }
 
         if (scroll_frame_id.has_value()) {
-            auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id.value());
-            auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
+            auto scroll_offset = scroll_offset_for_frame(scroll_frame_id.value());
             command.visit(
                 [&](auto& command) {
                     if constexpr (requires { command.translate_by(scroll_offset); }) {
@@ -149,6 +353,9 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         // clang-format on
     }
 
+    if (damaged_rect.has_value())
+        restore({});
+
     if (surface)
         flush();
 }
@@ -26,11 +26,12 @@ class DisplayListPlayer {
 public:
     virtual ~DisplayListPlayer() = default;
 
-    void execute(DisplayList&, ScrollStateSnapshot const&, RefPtr<Gfx::PaintingSurface>);
+    // NOTE: If a damaged rect is given, only the pixels inside it are repainted and everything outside is left untouched.
+    void execute(DisplayList&, ScrollStateSnapshot const&, RefPtr<Gfx::PaintingSurface>, Optional<Gfx::IntRect> damaged_rect = {});
 
 protected:
     Gfx::PaintingSurface& surface() const { return m_surfaces.last(); }
-    void execute_impl(DisplayList&, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface>);
+    void execute_impl(DisplayList&, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface>, Optional<Gfx::IntRect> damaged_rect = {});
 
 private:
     virtual void flush() = 0;
@@ -93,14 +94,49 @@ public:
 
     AK::SegmentedVector<CommandListItem, 512> const& commands() const { return m_commands; }
 
+    // A range of commands that leaves the painter state as it found it, along with the bounds of everything it paints.
+    // If all of those bounds are clipped out, the whole range can be skipped during replay.
+    struct CullingRange {
+        struct Bounds {
+            Optional<i32> scroll_frame_id;
+            Gfx::IntRect rect;
+        };
+
+        size_t start { 0 };
+        size_t end { 0 };
+        Vector<Bounds, 1> bounds;
+    };
+
+    // NOTE: Ranges are sorted by their start index. Ranges may be nested, but never partially overlap.
+    Vector<CullingRange> const& culling_ranges() const { return m_culling_ranges; }
+
     void set_device_pixels_per_css_pixel(double device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
 
+    // Whether disjoint regions of a surface can be painted from this display list on multiple threads at once.
+    // This is not the case if any command reads back from a surface that may be painted into concurrently.
+    bool can_be_replayed_in_parallel() const { return m_can_be_replayed_in_parallel; }
+
 private:
     DisplayList() = default;
 
+    struct CullingScope {
+        size_t segment_start { 0 };
+        Vector<CullingRange::Bounds, 1> segment_bounds;
+        bool segment_is_cullable { true };
+        Vector<CullingRange::Bounds, 1> scope_bounds;
+        bool scope_is_cullable { true };
+        // False inside of filters, and for every scope nested in them.
+        bool contents_may_be_culled { true };
+    };
+    void update_culling_index(Command const&, Optional<i32> scroll_frame_id, size_t command_index);
+    void end_culling_segment(CullingScope&, size_t end);
+
     AK::SegmentedVector<CommandListItem, 512> m_commands;
+    Vector<CullingRange> m_culling_ranges;
+    Vector<CullingScope> m_open_culling_scopes { CullingScope {} };
     double m_device_pixels_per_css_pixel;
+    bool m_can_be_replayed_in_parallel { true };
 };
 
 }
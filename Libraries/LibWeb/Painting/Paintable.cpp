@@ -161,19 +161,49 @@ StackingContext* Paintable::enclosing_stacking_context()
 void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
     auto& document = const_cast<DOM::Document&>(this->document());
-    if (should_invalidate_display_list == InvalidateDisplayList::Yes)
-        document.invalidate_display_list();
 
     auto* containing_block = this->containing_block();
-    if (!containing_block)
+    if (!containing_block || !is<Painting::PaintableWithLines>(*containing_block) || !absolute_rects_are_reliable_for_damage()) {
+        document.set_needs_display(should_invalidate_display_list);
         return;
+    }
 
-    if (!is<Painting::PaintableWithLines>(*containing_block))
-        return;
+    bool did_mark_damage = false;
     static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        document.set_needs_display(fragment.absolute_rect(), InvalidateDisplayList::No);
+        // NOTE: Glyphs may be painted slightly outside of their fragment (e.g. italic overhang).
+        auto rect = fragment.absolute_rect();
+        auto overhang = rect.height() / 2;
+        document.set_needs_display(rect.inflated(overhang, overhang, overhang, overhang), should_invalidate_display_list);
+        did_mark_damage = true;
         return IterationDecision::Continue;
     });
+
+    if (!did_mark_damage && should_invalidate_display_list == InvalidateDisplayList::Yes)
+        document.invalidate_display_list();
+}
+
+bool Paintable::absolute_rects_are_reliable_for_damage() const
+{
+    // NOTE: Absolute rects don't account for transforms, filters, text shadows, fixed and sticky positioning or the
+    //       scroll offsets of scroll containers, so we can't trust them if any of those apply.
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (!paintable->is_paintable_box())
+            continue;
+        auto const& paintable_box = static_cast<PaintableBox const&>(*paintable);
+        if (paintable_box.is_viewport())
+            return true;
+
+        auto const& computed_values = paintable_box.computed_values();
+        if (computed_values.position() == CSS::Positioning::Fixed || computed_values.position() == CSS::Positioning::Sticky)
+            return false;
+        if (paintable_box.has_css_transform() || computed_values.filter().has_value() || computed_values.backdrop_filter().has_value())
+            return false;
+        if (!computed_values.text_shadow().is_empty())
+            return false;
+        if (paintable != this && !paintable_box.scroll_offset().is_zero())
+            return false;
+    }
+    return false;
 }
 
 CSSPixelPoint Paintable::box_type_agnostic_position() const
@@ -117,6 +117,10 @@ public:
 
     virtual void set_needs_display(InvalidateDisplayList = InvalidateDisplayList::Yes);
 
+    // Whether the absolute rects of this paintable describe where it ends up in the viewport, so they can be used
+    // to only repaint the part of the viewport that changed.
+    bool absolute_rects_are_reliable_for_damage() const;
+
     PaintableBox* containing_block() const;
 
     template<typename T>
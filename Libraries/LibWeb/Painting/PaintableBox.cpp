@@ -1247,7 +1247,18 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
 
 void PaintableBox::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    document().set_needs_display(absolute_rect(), should_invalidate_display_list);
+    if (is_viewport() || !absolute_rects_are_reliable_for_damage()) {
+        document().set_needs_display(should_invalidate_display_list);
+        return;
+    }
+
+    auto rect = absolute_paint_rect();
+    if (auto const& outline_data = this->outline_data(); outline_data.has_value()) {
+        auto outline_width = max(max(outline_data->top.width, outline_data->right.width), max(outline_data->bottom.width, outline_data->left.width));
+        auto outline_extent = outline_width + max(outline_offset(), CSSPixels(0));
+        rect.inflate(outline_extent, outline_extent, outline_extent, outline_extent);
+    }
+    document().set_needs_display(rect, should_invalidate_display_list);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
@@ -200,7 +200,11 @@ public:
     BorderRadiiData const& border_radii_data() const { return m_border_radii_data; }
     void set_border_radii_data(BorderRadiiData const& border_radii_data) { m_border_radii_data = border_radii_data; }
 
-    void set_box_shadow_data(Vector<ShadowData> box_shadow_data) { m_box_shadow_data = move(box_shadow_data); }
+    void set_box_shadow_data(Vector<ShadowData> box_shadow_data)
+    {
+        m_box_shadow_data = move(box_shadow_data);
+        m_absolute_paint_rect.clear();
+    }
     Vector<ShadowData> const& box_shadow_data() const { return m_box_shadow_data; }
 
     void set_transform(Gfx::FloatMatrix4x4 transform) { m_transform = transform; }
@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/RefPtr.h>
+#include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
 
 namespace Web::Platform {
 
@@ -23,6 +26,8 @@ struct Frame {
 struct DecodedImage {
     bool is_animated { false };
     u32 loop_count { 0 };
+    // The size of the image itself. The frames may be smaller than this if they were decoded close to an ideal size.
+    Gfx::IntSize natural_size;
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
 };
@@ -34,7 +39,17 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    // If an ideal size is given, the frames may be decoded at a lower resolution that still covers that size.
+    // If a cache partition is given, the decoded image may be reused for other decodes of the same data that are made
+    // with the same partition. This should be the serialized top-level site of the document the image is used in.
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<String> cache_partition = {}) = 0;
+
+    // Decodes an image while its data is still being fetched. on_partial_image is invoked with the part of the image
+    // that could be decoded so far, and the complete image is resolved once the decode has been finished.
+    virtual ErrorOr<i64> start_incremental_decode(ESCAPING Function<void(DecodedImage&)> on_partial_image, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<String> cache_partition = {}) = 0;
+    virtual void append_to_incremental_decode(i64 image_id, ReadonlyBytes) = 0;
+    virtual void finish_incremental_decode(i64 image_id) = 0;
+    virtual void cancel_incremental_decode(i64 image_id) = 0;
 };
 
 }
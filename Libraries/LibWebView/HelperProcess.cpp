@@ -214,6 +214,9 @@ ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process()
         arguments.append(server.value());
     }
 
+    if (WebView::Application::web_content_options().enable_http_cache == WebView::EnableHTTPCache::Yes)
+        arguments.append("--enable-http-disk-cache"sv);
+
     auto client = TRY(launch_server_process<Requests::RequestClient>("RequestServer"sv, move(arguments)));
     WebView::Application::settings().dns_settings().visit(
         [](WebView::SystemDNS) {},
@@ -31,7 +31,21 @@ void ImageCodecPlugin::set_client(NonnullRefPtr<ImageDecoderClient::Client> clie
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+// FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+static Web::Platform::DecodedImage to_platform_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.natural_size = result.natural_size;
+    for (auto& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    decoded_image.color_space = move(result.color_space);
+    return decoded_image;
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<String> cache_partition)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -47,22 +61,56 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     auto image_decoder_promise = m_client->decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            decoded_image.color_space = move(result.color_space);
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_platform_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        ideal_size,
+        {},
+        move(cache_partition));
 
     return promise;
 }
 
+ErrorOr<i64> ImageCodecPlugin::start_incremental_decode(Function<void(Web::Platform::DecodedImage&)> on_partial_image, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<String> cache_partition)
+{
+    if (!m_client)
+        return Error::from_string_literal("ImageDecoderClient is disconnected");
+
+    return m_client->start_incremental_decode(
+        [on_partial_image = move(on_partial_image)](ImageDecoderClient::DecodedImage& result) {
+            auto decoded_image = to_platform_decoded_image(result);
+            on_partial_image(decoded_image);
+        },
+        [on_resolved = move(on_resolved)](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+            auto decoded_image = to_platform_decoded_image(result);
+            return on_resolved(decoded_image);
+        },
+        [on_rejected = move(on_rejected)](Error& error) {
+            on_rejected(error);
+        },
+        {},
+        move(cache_partition));
+}
+
+void ImageCodecPlugin::append_to_incremental_decode(i64 image_id, ReadonlyBytes bytes)
+{
+    if (m_client)
+        m_client->append_to_incremental_decode(image_id, bytes);
+}
+
+void ImageCodecPlugin::finish_incremental_decode(i64 image_id)
+{
+    if (m_client)
+        m_client->finish_incremental_decode(image_id);
+}
+
+void ImageCodecPlugin::cancel_incremental_decode(i64 image_id)
+{
+    if (m_client)
+        m_client->cancel_incremental_decode(image_id);
+}
+
 }
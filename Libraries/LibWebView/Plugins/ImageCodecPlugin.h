@@ -17,7 +17,12 @@ public:
     explicit ImageCodecPlugin(NonnullRefPtr<ImageDecoderClient::Client>);
     virtual ~ImageCodecPlugin() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<String> cache_partition = {}) override;
+
+    virtual ErrorOr<i64> start_incremental_decode(Function<void(Web::Platform::DecodedImage&)> on_partial_image, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<String> cache_partition = {}) override;
+    virtual void append_to_incremental_decode(i64 image_id, ReadonlyBytes) override;
+    virtual void finish_incremental_decode(i64 image_id) override;
+    virtual void cancel_incremental_decode(i64 image_id) override;
 
     void set_client(NonnullRefPtr<ImageDecoderClient::Client>);
 
@@ -30,12 +30,14 @@ WebContentClient::WebContentClient(NonnullOwnPtr<IPC::Transport> transport, View
 {
     s_clients.set(this);
     m_views.set(0, &view);
+    this->transport().enable_shared_memory_for_large_messages();
 }
 
 WebContentClient::WebContentClient(NonnullOwnPtr<IPC::Transport> transport)
     : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(transport))
 {
     s_clients.set(this);
+    this->transport().enable_shared_memory_for_large_messages();
 }
 
 WebContentClient::~WebContentClient()
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
+#include <LibImageDecoderClient/Client.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/ProcessManager.h>
 #include <LibWebView/WebUI/ProcessesUI.h>
@@ -23,6 +25,24 @@ void ProcessesUI::update_process_statistics()
     process_manager.update_all_process_statistics();
 
     async_send_message("loadProcessStatistics"sv, process_manager.serialize_json());
+
+    update_decoded_image_cache_statistics();
+}
+
+void ProcessesUI::update_decoded_image_cache_statistics()
+{
+    auto statistics = Application::image_decoder_client().send_sync_but_allow_failure<Messages::ImageDecoderServer::GetDecodedImageCacheStatistics>();
+    if (!statistics)
+        return;
+
+    JsonObject serialized;
+    serialized.set("hits"sv, statistics->hits());
+    serialized.set("misses"sv, statistics->misses());
+    serialized.set("evictions"sv, statistics->evictions());
+    serialized.set("entries"sv, statistics->entry_count());
+    serialized.set("size"sv, statistics->size_in_bytes());
+
+    async_send_message("loadDecodedImageCacheStatistics"sv, move(serialized));
 }
 
 }
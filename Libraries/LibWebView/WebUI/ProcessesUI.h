@@ -17,6 +17,7 @@ private:
     virtual void register_interfaces() override;
 
     void update_process_statistics();
+    void update_decoded_image_cache_statistics();
 };
 
 }
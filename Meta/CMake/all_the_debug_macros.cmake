@@ -22,6 +22,7 @@ set(HEAP_DEBUG ON)
 set(HIGHLIGHT_FOCUSED_FRAME_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
+set(HTTP_DISK_CACHE_DEBUG ON)
 set(HUNKS_DEBUG ON)
 set(ICO_DEBUG ON)
 set(IDB_DEBUG ON)
@@ -31,6 +32,7 @@ set(IMAGE_LOADER_DEBUG ON)
 set(JOB_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
 set(JS_MODULE_DEBUG ON)
+set(JS_PROPERTY_LOOKUP_CACHE_DEBUG ON)
 set(LEXER_DEBUG ON)
 set(LIBWEB_CSS_ANIMATION_DEBUG ON)
 set(LIBWEB_CSS_DEBUG ON)
@@ -45,6 +47,7 @@ set(NT_DEBUG ON)
 set(OPENTYPE_GPOS_DEBUG ON)
 set(HTML_PARSER_DEBUG ON)
 set(PATH_DEBUG ON)
+set(PAINT_DAMAGE_DEBUG ON)
 set(PLAYBACK_MANAGER_DEBUG ON)
 set(PNG_DEBUG ON)
 set(PROMISE_DEBUG ON)
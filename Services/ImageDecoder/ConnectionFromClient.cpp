@@ -7,6 +7,7 @@
 #include <AK/Debug.h>
 #include <AK/IDAllocator.h>
 #include <ImageDecoder/ConnectionFromClient.h>
+#include <ImageDecoder/DecodedImageCache.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
@@ -23,6 +24,8 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     s_connections.set(client_id(), *this);
 }
 
+ConnectionFromClient::~ConnectionFromClient() = default;
+
 void ConnectionFromClient::die()
 {
     for (auto& [_, job] : m_pending_jobs) {
@@ -30,6 +33,12 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, incremental_decode] : m_incremental_decodes) {
+        if (incremental_decode->partial_job)
+            incremental_decode->partial_job->cancel();
+    }
+    m_incremental_decodes.clear();
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
@@ -84,11 +93,14 @@ Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::co
     return files;
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<RefPtr<Gfx::Bitmap>>& bitmaps, Vector<u32>& durations)
+static ErrorOr<void> decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<RefPtr<Gfx::Bitmap>>& bitmaps, Vector<u32>& durations)
 {
     for (size_t i = 0; i < decoder.frame_count(); ++i) {
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
+            // NOTE: Some plugins only decode the image in frame(), so this is where we learn that a still image is broken.
+            if (decoder.frame_count() == 1)
+                return frame_or_error.release_error();
             bitmaps.append({});
             durations.append(0);
         } else {
@@ -97,6 +109,7 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
             durations.append(frame.duration);
         }
     }
+    return {};
 }
 
 static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
@@ -112,6 +125,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.natural_size = decoder->size();
 
     if (auto maybe_icc_data = decoder->color_space(); !maybe_icc_data.is_error())
         result.color_profile = maybe_icc_data.value();
@@ -132,24 +146,77 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    TRY(decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations));
 
     if (bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
 
-    result.bitmaps = Gfx::BitmapSequence { move(bitmaps) };
+    // NOTE: The frames are handed to the client as shared memory, which also lets every client that gets this result
+    //       from the decoded image cache map the same pixels.
+    TRY(result.bitmaps.try_ensure_capacity(bitmaps.size()));
+    for (auto const& bitmap : bitmaps) {
+        if (!bitmap) {
+            result.bitmaps.unchecked_append({});
+            continue;
+        }
+        auto shared_bitmap = TRY(bitmap->to_bitmap_backed_by_anonymous_buffer());
+        result.bitmaps.unchecked_append(Gfx::ShareableBitmap { move(shared_bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap });
+    }
+
+    return result;
+}
+
+static ErrorOr<ConnectionFromClient::PartialDecodeResult> decode_partial_image(ReadonlyBytes encoded_data, Optional<ByteString> const& known_mime_type)
+{
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, known_mime_type));
+
+    if (!decoder)
+        return Error::from_string_literal("Could not find suitable image decoder plugin for data");
+
+    // NOTE: Animations are only shown once all of their frames have arrived.
+    if (decoder->is_animated())
+        return Error::from_string_literal("Partial decoding of animated images is not supported");
+
+    auto frame = TRY(decoder->partial_frame());
+
+    ConnectionFromClient::PartialDecodeResult result;
+    result.bitmaps = Gfx::BitmapSequence { Vector<RefPtr<Gfx::Bitmap>> { frame.image } };
+
+    if (auto maybe_icc_data = decoder->color_space(); !maybe_icc_data.is_error())
+        result.color_profile = maybe_icc_data.release_value();
 
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<String> cache_partition)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type), cache_partition = move(cache_partition)](auto&) -> ErrorOr<DecodeResult> {
+            // NOTE: Clients that can't tell us which site an image is shown on don't get to share decoded images.
+            if (!cache_partition.has_value())
+                return decode_image_to_details(encoded_buffer, ideal_size, mime_type);
+
+            // OPTIMIZATION: The same images are often sent to us again, e.g. logos and sprite sheets that are used on
+            //               every page of a site, or pages that are loaded again. Hand out the bitmaps we already decoded.
+            auto& cache = DecodedImageCache::the();
+            ReadonlyBytes encoded_data { encoded_buffer.data<u8>(), encoded_buffer.size() };
+            Optional<DecodedImageCache::Key> key;
+            if (cache.may_contain_entry_for(encoded_data)) {
+                key = DecodedImageCache::Key::create(*cache_partition, encoded_data, ideal_size, mime_type);
+                if (auto cached_result = cache.get(*key); cached_result.has_value())
+                    return cached_result.release_value();
+            }
+
+            auto result = TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+            if (cache.would_store(result)) {
+                if (!key.has_value())
+                    key = DecodedImageCache::Key::create(*cache_partition, encoded_data, ideal_size, mime_type);
+                cache.set(key.release_value(), result);
+            }
+            return result;
         },
         [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations), result.scale, move(result.color_profile));
+            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations), result.scale, result.natural_size, move(result.color_profile));
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
@@ -160,7 +227,7 @@ NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image
         });
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<String> cache_partition)
 {
     auto image_id = m_next_image_id++;
 
@@ -170,7 +237,7 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), ideal_size, move(mime_type)));
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), ideal_size, move(mime_type), move(cache_partition)));
 
     return image_id;
 }
@@ -180,6 +247,117 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
         job.value()->cancel();
     }
+
+    if (auto incremental_decode = m_incremental_decodes.take(image_id); incremental_decode.has_value()) {
+        if (auto& partial_job = incremental_decode.value()->partial_job)
+            partial_job->cancel();
+    }
+}
+
+Messages::ImageDecoderServer::StartIncrementalDecodeResponse ConnectionFromClient::start_incremental_decode(Optional<ByteString> mime_type, Optional<String> cache_partition)
+{
+    auto image_id = m_next_image_id++;
+
+    auto incremental_decode = make<IncrementalDecode>();
+    incremental_decode->mime_type = move(mime_type);
+    incremental_decode->cache_partition = move(cache_partition);
+    m_incremental_decodes.set(image_id, move(incremental_decode));
+
+    return image_id;
+}
+
+void ConnectionFromClient::append_to_incremental_decode(i64 image_id, ByteBuffer data)
+{
+    auto incremental_decode = m_incremental_decodes.get(image_id);
+    if (!incremental_decode.has_value())
+        return;
+
+    if (auto result = (*incremental_decode)->encoded_data.try_append(data); result.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Failed to append to incremental decode {}: {}", image_id, result.error());
+        return;
+    }
+
+    schedule_partial_decode_if_needed(image_id);
+}
+
+void ConnectionFromClient::schedule_partial_decode_if_needed(i64 image_id)
+{
+    // NOTE: Every partial decode starts over from the beginning of the data, so only decode again once a meaningful
+    //       amount of new data has arrived. Requiring the data to grow geometrically keeps the total amount of work
+    //       proportional to the size of the image.
+    static constexpr size_t minimum_growth_between_partial_decodes = 64 * KiB;
+
+    auto incremental_decode = m_incremental_decodes.get(image_id);
+    if (!incremental_decode.has_value())
+        return;
+
+    auto& state = **incremental_decode;
+    if (state.partial_job)
+        return;
+
+    auto minimum_growth = max(minimum_growth_between_partial_decodes, state.size_at_last_partial_decode / 4);
+    if (state.encoded_data.size() < state.size_at_last_partial_decode + minimum_growth)
+        return;
+
+    auto encoded_data = ByteBuffer::copy(state.encoded_data);
+    if (encoded_data.is_error())
+        return;
+
+    state.size_at_last_partial_decode = state.encoded_data.size();
+    state.partial_job = PartialJob::construct(
+        [encoded_data = encoded_data.release_value(), mime_type = state.mime_type](auto&) -> ErrorOr<PartialDecodeResult> {
+            return decode_partial_image(encoded_data, mime_type);
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](PartialDecodeResult result) -> ErrorOr<void> {
+            auto incremental_decode = strong_this->m_incremental_decodes.get(image_id);
+            if (!incremental_decode.has_value())
+                return {};
+
+            (*incremental_decode)->partial_job = nullptr;
+            strong_this->async_did_decode_partial_image(image_id, move(result.bitmaps), move(result.color_profile));
+            strong_this->schedule_partial_decode_if_needed(image_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // NOTE: Canceled jobs report their error from the background thread, so we must not touch any state here.
+            if (error.code() == ECANCELED)
+                return;
+
+            dbgln_if(IMAGE_DECODER_DEBUG, "Partial decode of image {} failed: {}", image_id, error);
+
+            auto incremental_decode = strong_this->m_incremental_decodes.get(image_id);
+            if (!incremental_decode.has_value())
+                return;
+
+            (*incremental_decode)->partial_job = nullptr;
+            strong_this->schedule_partial_decode_if_needed(image_id);
+        });
+}
+
+void ConnectionFromClient::finish_incremental_decode(i64 image_id)
+{
+    auto incremental_decode = m_incremental_decodes.take(image_id);
+    if (!incremental_decode.has_value())
+        return;
+
+    auto& state = **incremental_decode;
+    if (state.partial_job)
+        state.partial_job->cancel();
+
+    auto encoded_buffer = Core::AnonymousBuffer::create_with_size(state.encoded_data.size());
+    if (encoded_buffer.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", encoded_buffer.error())));
+        return;
+    }
+    memcpy(encoded_buffer.value().data<void>(), state.encoded_data.data(), state.encoded_data.size());
+
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer.release_value(), {}, move(state.mime_type), move(state.cache_partition)));
+}
+
+Messages::ImageDecoderServer::GetDecodedImageCacheStatisticsResponse ConnectionFromClient::get_decoded_image_cache_statistics()
+{
+    auto statistics = DecodedImageCache::the().statistics();
+    return { statistics.hits, statistics.misses, statistics.evictions, statistics.entry_count, statistics.size_in_bytes };
 }
 
 }
@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibGfx/BitmapSequence.h>
 #include <LibGfx/ColorSpace.h>
+#include <LibGfx/ShareableBitmap.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
 
@@ -22,7 +24,7 @@ class ConnectionFromClient final
     C_OBJECT(ConnectionFromClient);
 
 public:
-    ~ConnectionFromClient() override = default;
+    ~ConnectionFromClient() override;
 
     virtual void die() override;
 
@@ -30,27 +32,50 @@ public:
         bool is_animated = false;
         u32 loop_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
-        Gfx::BitmapSequence bitmaps;
+        Gfx::IntSize natural_size;
+        Vector<Gfx::ShareableBitmap> bitmaps;
         Vector<u32> durations;
         Gfx::ColorSpace color_profile;
     };
 
+    struct PartialDecodeResult {
+        Gfx::BitmapSequence bitmaps;
+        Gfx::ColorSpace color_profile;
+    };
+
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using PartialJob = Threading::BackgroundAction<PartialDecodeResult>;
+
+    // An image whose encoded data is still arriving. We periodically decode what we have so far, so that the client
+    // can show the image progressively while it loads.
+    struct IncrementalDecode {
+        ByteBuffer encoded_data;
+        Optional<ByteString> mime_type;
+        Optional<String> cache_partition;
+        size_t size_at_last_partial_decode { 0 };
+        RefPtr<PartialJob> partial_job;
+    };
 
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<String> cache_partition) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::StartIncrementalDecodeResponse start_incremental_decode(Optional<ByteString> mime_type, Optional<String> cache_partition) override;
+    virtual void append_to_incremental_decode(i64 image_id, ByteBuffer data) override;
+    virtual void finish_incremental_decode(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::GetDecodedImageCacheStatisticsResponse get_decoded_image_cache_statistics() override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
     virtual Messages::ImageDecoderServer::InitTransportResponse init_transport(int peer_pid) override;
 
     ErrorOr<IPC::File> connect_new_client();
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, Optional<String> cache_partition);
+    void schedule_partial_decode_if_needed(i64 image_id);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullOwnPtr<IncrementalDecode>> m_incremental_decodes;
 };
 
 }
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/DecodedImageCache.h>
+#include <LibGfx/Bitmap.h>
+
+namespace ImageDecoder {
+
+DecodedImageKey DecodedImageKey::create(String partition, ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    // NOTE: The decoded result depends on the requested size and the decoder that is picked for the data, so those
+    //       have to be part of the key as well.
+    return {
+        .partition = move(partition),
+        .encoded_size = encoded_data.size(),
+        .digest = Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size()),
+        .ideal_size = ideal_size,
+        .mime_type = move(mime_type),
+    };
+}
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static auto cache = DecodedImageCache::create();
+    return *cache;
+}
+
+NonnullRefPtr<DecodedImageCache> DecodedImageCache::create(size_t maximum_size)
+{
+    return adopt_ref(*new DecodedImageCache(maximum_size));
+}
+
+DecodedImageCache::DecodedImageCache(size_t maximum_size)
+    : m_maximum_size(maximum_size)
+{
+}
+
+static size_t size_in_bytes_of(ConnectionFromClient::DecodeResult const& result)
+{
+    size_t size_in_bytes = 0;
+    for (auto const& bitmap : result.bitmaps) {
+        if (bitmap.is_valid())
+            size_in_bytes += bitmap.bitmap()->size_in_bytes();
+    }
+    return size_in_bytes;
+}
+
+bool DecodedImageCache::may_contain_entry_for(ReadonlyBytes encoded_data)
+{
+    Threading::MutexLocker locker { m_mutex };
+    if (m_entry_count_by_encoded_size.contains(encoded_data.size()))
+        return true;
+    ++m_misses;
+    return false;
+}
+
+bool DecodedImageCache::would_store(ConnectionFromClient::DecodeResult const& result) const
+{
+    // NOTE: An image that would take up a large part of the budget by itself would just push everything else out.
+    return size_in_bytes_of(result) <= m_maximum_size / 4;
+}
+
+Optional<ConnectionFromClient::DecodeResult> DecodedImageCache::get(Key const& key)
+{
+    Threading::MutexLocker locker { m_mutex };
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_misses;
+        return {};
+    }
+
+    ++m_hits;
+
+    auto& entry = *it->value;
+    m_lru_list.remove(entry);
+    m_lru_list.append(entry);
+
+    // NOTE: This only copies the references to the decoded bitmaps. They are sent to the client as shared memory, so
+    //       a hit doesn't copy any pixels either. Only clients in the same partition ever get to see these bitmaps.
+    return entry.result;
+}
+
+void DecodedImageCache::set(Key key, ConnectionFromClient::DecodeResult const& result)
+{
+    if (!would_store(result))
+        return;
+    auto size_in_bytes = size_in_bytes_of(result);
+
+    Threading::MutexLocker locker { m_mutex };
+
+    if (auto existing_entry = m_entries.get(key); existing_entry.has_value())
+        remove_entry(**existing_entry);
+
+    auto entry = adopt_own(*new Entry { .key = key, .result = result, .size_in_bytes = size_in_bytes, .lru_list_node = {} });
+    m_lru_list.append(*entry);
+    m_current_size += size_in_bytes;
+    ++m_entry_count_by_encoded_size.ensure(key.encoded_size);
+    m_entries.set(move(key), move(entry));
+
+    evict_entries_if_needed();
+}
+
+void DecodedImageCache::remove_entry(Entry& entry)
+{
+    m_lru_list.remove(entry);
+    m_current_size -= entry.size_in_bytes;
+
+    auto count = m_entry_count_by_encoded_size.find(entry.key.encoded_size);
+    VERIFY(count != m_entry_count_by_encoded_size.end());
+    if (--count->value == 0)
+        m_entry_count_by_encoded_size.remove(count);
+
+    // NOTE: This destroys the entry.
+    auto key = entry.key;
+    m_entries.remove(key);
+}
+
+void DecodedImageCache::evict_entries_if_needed()
+{
+    while (m_current_size > m_maximum_size) {
+        VERIFY(!m_lru_list.is_empty());
+        ++m_evictions;
+        remove_entry(*m_lru_list.first());
+    }
+}
+
+DecodedImageCache::Statistics DecodedImageCache::statistics() const
+{
+    Threading::MutexLocker locker { m_mutex };
+
+    return {
+        .hits = m_hits,
+        .misses = m_misses,
+        .evictions = m_evictions,
+        .entry_count = m_entries.size(),
+        .size_in_bytes = m_current_size,
+    };
+}
+
+}
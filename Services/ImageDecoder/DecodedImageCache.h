@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteReader.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <ImageDecoder/ConnectionFromClient.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Size.h>
+#include <LibThreading/Mutex.h>
+
+namespace ImageDecoder {
+
+struct DecodedImageKey {
+    String partition;
+    size_t encoded_size { 0 };
+    Crypto::Hash::SHA256::DigestType digest;
+    Optional<Gfx::IntSize> ideal_size;
+    Optional<ByteString> mime_type;
+
+    static DecodedImageKey create(String partition, ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+
+    bool operator==(DecodedImageKey const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<ImageDecoder::DecodedImageKey> : public DefaultTraits<ImageDecoder::DecodedImageKey> {
+    static unsigned hash(ImageDecoder::DecodedImageKey const& key)
+    {
+        // NOTE: The digest is already uniformly distributed, so any part of it makes for a good hash.
+        auto hash = pair_int_hash(ByteReader::load32(key.digest.data), key.partition.hash());
+        if (key.ideal_size.has_value())
+            hash = pair_int_hash(hash, pair_int_hash(key.ideal_size->width(), key.ideal_size->height()));
+        if (key.mime_type.has_value())
+            hash = pair_int_hash(hash, key.mime_type->hash());
+        return hash;
+    }
+};
+
+}
+
+namespace ImageDecoder {
+
+// Keeps the results of recent decodes around, keyed by a hash of the encoded image data, so that images which are
+// used again (e.g. on every page of a site, by every tab showing that site, or after navigating back) only need to be
+// decoded once. The decoded bitmaps live in shared memory, so every client that is handed an entry maps the same pixels.
+// NOTE: There is one cache for all clients, but it is partitioned by the top-level site of the page that asked for the
+//       decode. Otherwise a page could tell from the decoding time whether a page of another site has recently shown
+//       the same image.
+// NOTE: This is accessed from the background thread that runs the decoding jobs.
+class DecodedImageCache : public AtomicRefCounted<DecodedImageCache> {
+    AK_MAKE_NONCOPYABLE(DecodedImageCache);
+    AK_MAKE_NONMOVABLE(DecodedImageCache);
+
+public:
+    static constexpr size_t default_maximum_size = 32 * MiB;
+
+    static DecodedImageCache& the();
+    static NonnullRefPtr<DecodedImageCache> create(size_t maximum_size = default_maximum_size);
+
+    using Key = DecodedImageKey;
+
+    // OPTIMIZATION: These allow skipping the hashing of the encoded data when the cache can't have an entry for it,
+    //               or wouldn't store the result of decoding it.
+    bool may_contain_entry_for(ReadonlyBytes encoded_data);
+    bool would_store(ConnectionFromClient::DecodeResult const&) const;
+
+    Optional<ConnectionFromClient::DecodeResult> get(Key const&);
+    void set(Key, ConnectionFromClient::DecodeResult const&);
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        size_t entry_count { 0 };
+        size_t size_in_bytes { 0 };
+    };
+    Statistics statistics() const;
+
+private:
+    explicit DecodedImageCache(size_t maximum_size);
+
+    struct Entry {
+        Key key;
+        ConnectionFromClient::DecodeResult result;
+        size_t size_in_bytes { 0 };
+
+        IntrusiveListNode<Entry> lru_list_node;
+    };
+
+    void remove_entry(Entry&);
+    void evict_entries_if_needed();
+
+    mutable Threading::Mutex m_mutex;
+
+    HashMap<Key, NonnullOwnPtr<Entry>> m_entries;
+    HashMap<size_t, size_t> m_entry_count_by_encoded_size;
+    IntrusiveList<&Entry::lru_list_node> m_lru_list;
+
+    size_t m_maximum_size { 0 };
+    size_t m_current_size { 0 };
+
+    u64 m_hits { 0 };
+    u64 m_misses { 0 };
+    u64 m_evictions { 0 };
+};
+
+}
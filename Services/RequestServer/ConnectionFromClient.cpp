@@ -11,6 +11,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
 #include <LibRequests/NetworkError.h>
@@ -99,6 +100,83 @@ ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringVi
     return resolve_opt_builder.to_byte_string();
 }
 
+static constexpr size_t cached_body_chunk_size = 64 * KiB;
+
+// NOTE: Stored bodies are passed on to the client a chunk at a time, as it drains the pipe, rather than read into
+//       memory in one go on the event loop.
+static void queue_next_chunk_of_cached_body(OwnPtr<Core::File>& cached_body, AllocatingMemoryStream& send_buffer)
+{
+    auto chunk = MUST(ByteBuffer::create_uninitialized(cached_body_chunk_size));
+    auto bytes_read = cached_body->read_some(chunk);
+    if (bytes_read.is_error())
+        dbgln("ConnectionFromClient: Unable to read cached body: {}", bytes_read.error());
+    if (bytes_read.is_error() || bytes_read.value().is_empty()) {
+        cached_body = nullptr;
+        return;
+    }
+    MUST(send_buffer.write_until_depleted(bytes_read.value()));
+}
+
+// Sends a response body from the disk cache to the client, through the same kind of pipe as a response from the network.
+struct ConnectionFromClient::CachedBodyStream : public Weakable<CachedBodyStream> {
+    i32 request_id { 0 };
+    WeakPtr<ConnectionFromClient> client;
+    int writer_fd { 0 };
+    OwnPtr<Core::File> cached_body;
+    AllocatingMemoryStream send_buffer;
+    NonnullRefPtr<Core::Notifier> write_notifier;
+
+    CachedBodyStream(ConnectionFromClient& client, i32 request_id, int writer_fd, NonnullOwnPtr<Core::File> cached_body)
+        : request_id(request_id)
+        , client(client)
+        , writer_fd(writer_fd)
+        , cached_body(move(cached_body))
+        , write_notifier(Core::Notifier::construct(writer_fd, Core::NotificationType::Write))
+    {
+        write_notifier->set_enabled(false);
+        write_notifier->on_activation = [this] {
+            write_queued_bytes_without_blocking();
+        };
+    }
+
+    ~CachedBodyStream()
+    {
+        MUST(Core::System::close(writer_fd));
+    }
+
+    void write_queued_bytes_without_blocking()
+    {
+        while (true) {
+            if (send_buffer.is_eof() && cached_body)
+                queue_next_chunk_of_cached_body(cached_body, send_buffer);
+            if (send_buffer.is_eof())
+                break;
+
+            Vector<u8> bytes_to_send;
+            bytes_to_send.resize(send_buffer.used_buffer_size());
+            send_buffer.peek_some(bytes_to_send);
+            auto result = Core::System::write(writer_fd, bytes_to_send);
+            if (result.is_error()) {
+                if (result.error().code() != EAGAIN) {
+                    dbgln("ConnectionFromClient: Unable to send cached body: {}", result.error());
+                    break;
+                }
+                write_notifier->set_enabled(true);
+                return;
+            }
+            MUST(send_buffer.discard(result.value()));
+        }
+
+        write_notifier->set_enabled(false);
+        Core::deferred_invoke([weak_this = make_weak_ptr()] {
+            if (!weak_this)
+                return;
+            if (weak_this->client)
+                weak_this->client->m_cached_body_streams.remove(weak_this->request_id);
+        });
+    }
+};
+
 struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
     CURLM* multi { nullptr };
     CURL* easy { nullptr };
@@ -117,6 +195,15 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
     NonnullRefPtr<Core::Notifier> write_notifier;
     bool done_fetching { false };
 
+    ByteString method;
+    HTTP::HeaderMap request_headers;
+    UnixDateTime request_time;
+    Optional<ByteString> cache_key;
+    Optional<ByteString> cache_key_to_invalidate;
+    bool is_revalidating_cached_response { false };
+    OwnPtr<DiskCache::EntryWriter> cache_entry_writer;
+    OwnPtr<Core::File> cached_body;
+
     ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
         : multi(multi)
         , easy(easy)
@@ -143,6 +230,9 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
 
     void write_queued_bytes_without_blocking()
     {
+        if (send_buffer.is_eof() && cached_body)
+            queue_next_chunk_of_cached_body(cached_body, send_buffer);
+
         Vector<u8> bytes_to_send;
         bytes_to_send.resize(send_buffer.used_buffer_size());
         send_buffer.peek_some(bytes_to_send);
@@ -156,15 +246,15 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
         }
 
         MUST(send_buffer.discard(result.value()));
-        write_notifier->set_enabled(!send_buffer.is_eof());
-        if (send_buffer.is_eof() && done_fetching)
+        write_notifier->set_enabled(!send_buffer.is_eof() || cached_body);
+        if (send_buffer.is_eof() && !cached_body && done_fetching)
             schedule_self_destruction();
     }
 
     void notify_about_fetching_completion()
     {
         done_fetching = true;
-        if (send_buffer.is_eof())
+        if (send_buffer.is_eof() && !cached_body)
             schedule_self_destruction();
     }
 
@@ -191,8 +281,42 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
+
+        if (g_disk_cache && cache_key.has_value()) {
+            if (http_status_code == 304 && is_revalidating_cached_response) {
+                if (serve_revalidated_response_from_disk_cache())
+                    return;
+            } else if (DiskCache::is_storable(method, request_headers, http_status_code, headers)) {
+                cache_entry_writer = g_disk_cache->create_entry_writer(*cache_key, http_status_code, reason_phrase, headers, request_time);
+            }
+        }
+
         client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
     }
+
+    // https://httpwg.org/specs/rfc9111.html#validation.response
+    // The server confirmed that our stored response is still valid, so send that to the client in its place.
+    bool serve_revalidated_response_from_disk_cache()
+    {
+        auto entry = g_disk_cache->entry_for(*cache_key);
+        if (!entry.has_value())
+            return false;
+
+        auto body = g_disk_cache->open_body(*entry);
+        if (body.is_error()) {
+            dbgln("ConnectionFromClient: Unable to open cached body for {}: {}", *cache_key, body.error());
+            g_disk_cache->remove_entry(*cache_key);
+            return false;
+        }
+
+        g_disk_cache->freshen_entry_upon_validation(*entry, headers, request_time);
+        client->async_headers_became_available(request_id, entry->response_headers, entry->status_code, entry->reason_phrase);
+
+        cached_body = body.release_value();
+        downloaded_so_far += entry->body_size;
+        write_queued_bytes_without_blocking();
+        return true;
+    }
 };
 
 size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data)
@@ -234,6 +358,8 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
 
     size_t total_size = size * nmemb;
     ReadonlyBytes bytes { static_cast<u8 const*>(buffer), total_size };
+    if (request->cache_entry_writer)
+        request->cache_entry_writer->append(bytes);
     MUST(request->send_buffer.write_some(bytes));
     request->write_queued_bytes_without_blocking();
     request->downloaded_so_far += total_size;
@@ -299,6 +425,7 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     , m_resolver(default_resolver())
 {
     s_connections.set(client_id(), *this);
+    this->transport().enable_shared_memory_for_large_messages();
 
     m_curl_multi = curl_multi_init();
 
@@ -410,13 +537,66 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+bool ConnectionFromClient::serve_from_disk_cache(i32 request_id, DiskCache::Entry& entry)
 {
+    auto body = g_disk_cache->open_body(entry);
+    if (body.is_error()) {
+        dbgln("StartRequest: Unable to open cached body for {}: {}", entry.key, body.error());
+        auto key = entry.key;
+        g_disk_cache->remove_entry(key);
+        return false;
+    }
+
+    auto fds = Core::System::pipe2(O_NONBLOCK);
+    if (fds.is_error()) {
+        dbgln("StartRequest: Failed to create pipe: {}", fds.error());
+        return false;
+    }
+
+    auto writer_fd = fds.value()[1];
+    auto reader_fd = fds.value()[0];
+    async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
+    async_headers_became_available(request_id, entry.response_headers, entry.status_code, entry.reason_phrase);
+    async_request_finished(request_id, entry.body_size, {}, {});
+
+    auto stream = make<CachedBodyStream>(*this, request_id, writer_fd, body.release_value());
+    auto& stream_ref = *stream;
+    m_cached_body_streams.set(request_id, move(stream));
+    stream_ref.write_queued_bytes_without_blocking();
+    return true;
+}
+
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<ByteString> cache_partition)
+{
+    Optional<ByteString> cache_key;
+    Optional<ByteString> cache_key_to_invalidate;
+    bool is_revalidating_cached_response = false;
+
+    if (g_disk_cache) {
+        cache_key = DiskCache::cache_key_for(method, url, cache_partition);
+
+        if (cache_key.has_value() && DiskCache::can_use_stored_response(request_headers)) {
+            if (auto lookup = g_disk_cache->lookup(*cache_key); lookup.has_value()) {
+                if (lookup->freshness == DiskCache::Freshness::Fresh) {
+                    if (serve_from_disk_cache(request_id, lookup->entry))
+                        return;
+                } else {
+                    is_revalidating_cached_response = DiskCache::add_validation_headers(lookup->entry, request_headers);
+                }
+            }
+        }
+
+        // https://httpwg.org/specs/rfc9111.html#invalidation
+        // A cache MUST invalidate the target URI when it receives a non-error status code in response to an unsafe request method.
+        if (!method.is_one_of("GET"sv, "HEAD"sv, "OPTIONS"sv, "TRACE"sv))
+            cache_key_to_invalidate = DiskCache::cache_key_for("GET"sv, url, cache_partition);
+    }
+
     auto host = url.serialized_host().to_byte_string();
 
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
@@ -425,7 +605,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             // FIXME: Implement timing info for DNS lookup failure.
             async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, cache_key = move(cache_key), cache_key_to_invalidate = move(cache_key_to_invalidate), is_revalidating_cached_response](auto const& dns_result) mutable {
             if (dns_result->records().is_empty() || dns_result->cached_addresses().is_empty()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
                 // FIXME: Implement timing info for DNS lookup failure.
@@ -452,6 +632,12 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
 
             auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
             request->url = url.to_string();
+            request->method = method;
+            request->request_headers = request_headers;
+            request->request_time = UnixDateTime::now();
+            request->cache_key = move(cache_key);
+            request->cache_key_to_invalidate = move(cache_key_to_invalidate);
+            request->is_revalidating_cached_response = is_revalidating_cached_response;
 
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
@@ -686,6 +872,20 @@ void ConnectionFromClient::check_active_requests()
                 }
             }
 
+            if (request->cache_entry_writer) {
+                if (request_was_successful)
+                    request->cache_entry_writer->commit();
+                request->cache_entry_writer = nullptr;
+            }
+
+            if (request->cache_key_to_invalidate.has_value() && request_was_successful) {
+                long http_status_code = 0;
+                auto status_result = curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_status_code);
+                VERIFY(status_result == CURLE_OK);
+                if (http_status_code >= 200 && http_status_code < 400)
+                    g_disk_cache->remove_entry(*request->cache_key_to_invalidate);
+            }
+
             async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
         }
 
@@ -695,6 +895,9 @@ void ConnectionFromClient::check_active_requests()
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
+    if (m_cached_body_streams.remove(request_id))
+        return true;
+
     auto request = m_active_requests.take(request_id);
     if (!request.has_value()) {
         dbgln("StopRequest: Request ID {} not found", request_id);
@@ -10,6 +10,7 @@
 #include <LibDNS/Resolver.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
 
@@ -42,7 +43,7 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
@@ -57,6 +58,9 @@ private:
     struct ActiveRequest;
     friend struct ActiveRequest;
 
+    struct CachedBodyStream;
+    friend struct CachedBodyStream;
+
     static int on_socket_callback(void*, int sockfd, int what, void* user_data, void*);
     static int on_timeout_callback(void*, long timeout_ms, void* user_data);
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
@@ -64,6 +68,10 @@ private:
 
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
+    HashMap<i32, NonnullOwnPtr<CachedBodyStream>> m_cached_body_streams;
+
+    bool serve_from_disk_cache(i32 request_id, DiskCache::Entry&);
+
     void check_active_requests();
     void* m_curl_multi { nullptr };
     RefPtr<Core::Timer> m_timer;
@@ -0,0 +1,672 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+#include <fcntl.h>
+
+namespace RequestServer {
+
+OwnPtr<DiskCache> g_disk_cache;
+
+static constexpr u32 index_magic = 0x4c424843; // "LBHC"
+static constexpr u32 index_version = 1;
+static constexpr StringView index_file_name = "index"sv;
+static constexpr StringView lock_file_name = "lock"sv;
+static constexpr int index_write_delay_ms = 1000;
+
+static Optional<UnixDateTime> parse_http_date(StringView value)
+{
+    // https://httpwg.org/specs/rfc9110.html#http.date
+    // NOTE: Only the preferred IMF-fixdate format is supported. Anything else is treated as an invalid date, which makes
+    //       us err on the side of considering responses stale.
+    auto date = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, value);
+    if (!date.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date->timestamp());
+}
+
+static Optional<UnixDateTime> header_date(HTTP::HeaderMap const& headers, StringView name)
+{
+    if (auto value = headers.get(name); value.has_value())
+        return parse_http_date(*value);
+    return {};
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+// Returns the argument of the given directive, or an empty string view if the directive doesn't have one.
+static Optional<StringView> cache_control_directive(HTTP::HeaderMap const& headers, StringView directive_name)
+{
+    auto cache_control = headers.get("Cache-Control"sv);
+    if (!cache_control.has_value())
+        return {};
+
+    for (auto directive : cache_control->split_view(',')) {
+        directive = directive.trim_whitespace();
+
+        auto name = directive;
+        StringView argument;
+        if (auto equals_index = directive.find('='); equals_index.has_value()) {
+            name = directive.substring_view(0, *equals_index).trim_whitespace();
+            argument = directive.substring_view(*equals_index + 1).trim_whitespace().trim("\""sv);
+        }
+
+        if (name.equals_ignoring_ascii_case(directive_name))
+            return argument;
+    }
+
+    return {};
+}
+
+static bool has_cache_control_directive(HTTP::HeaderMap const& headers, StringView directive_name)
+{
+    return cache_control_directive(headers, directive_name).has_value();
+}
+
+// https://httpwg.org/specs/rfc9110.html#overview.of.status.codes
+static bool is_heuristically_cacheable_status(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+static AK::Duration freshness_lifetime(DiskCache::Entry const& entry)
+{
+    auto const& headers = entry.response_headers;
+
+    // NOTE: This is a private cache, so s-maxage doesn't apply.
+    if (auto max_age = cache_control_directive(headers, "max-age"sv); max_age.has_value())
+        return AK::Duration::from_seconds(max_age->to_number<i64>().value_or(0));
+
+    auto date = header_date(headers, "Date"sv).value_or(entry.response_time);
+
+    if (auto expires = headers.get("Expires"sv); expires.has_value()) {
+        // An invalid date, e.g. "0", represents a time in the past.
+        auto expiration_time = parse_http_date(*expires);
+        if (!expiration_time.has_value())
+            return {};
+        return *expiration_time - date;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    // A typical heuristic is 10% of the interval since the Last-Modified time.
+    if (is_heuristically_cacheable_status(entry.status_code)) {
+        if (auto last_modified = header_date(headers, "Last-Modified"sv); last_modified.has_value() && *last_modified < date)
+            return AK::Duration::from_milliseconds((date - *last_modified).to_milliseconds() / 10);
+    }
+
+    return {};
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+static AK::Duration current_age(DiskCache::Entry const& entry, UnixDateTime now)
+{
+    auto const& headers = entry.response_headers;
+
+    i64 age_in_seconds = 0;
+    if (auto age = headers.get("Age"sv); age.has_value())
+        age_in_seconds = age->to_number<i64>().value_or(0);
+    auto age_value = AK::Duration::from_seconds(age_in_seconds);
+    auto date_value = header_date(headers, "Date"sv).value_or(entry.response_time);
+
+    auto apparent_age = max(AK::Duration {}, entry.response_time - date_value);
+    auto response_delay = entry.response_time - entry.request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+    auto resident_time = now - entry.response_time;
+
+    return corrected_initial_age + resident_time;
+}
+
+static ByteString body_file_name_for(StringView key)
+{
+    auto digest = Crypto::Hash::SHA256::hash(key.bytes());
+    return encode_hex(digest.bytes());
+}
+
+Optional<ByteString> DiskCache::cache_key_for(StringView method, URL::URL const& url, Optional<ByteString> const& partition)
+{
+    if (method != "GET"sv || !partition.has_value() || partition->is_empty())
+        return {};
+    if (!url.scheme().is_one_of("http"sv, "https"sv))
+        return {};
+
+    // The cache key is the target URI of the request (https://httpwg.org/specs/rfc9111.html#cache.keys), which
+    // doesn't include the fragment.
+    auto url_without_fragment = url;
+    url_without_fragment.set_fragment({});
+
+    return ByteString::formatted("{} {}", *partition, url_without_fragment.serialize());
+}
+
+bool DiskCache::can_use_stored_response(HTTP::HeaderMap const& request_headers)
+{
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-cache
+    if (has_cache_control_directive(request_headers, "no-cache"sv) || has_cache_control_directive(request_headers, "no-store"sv))
+        return false;
+    if (auto pragma = request_headers.get("Pragma"sv); pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+        return false;
+
+    // NOTE: Conditional and range requests are made by a client that manages its own copy of the response.
+    for (auto header : { "If-None-Match"sv, "If-Modified-Since"sv, "If-Match"sv, "If-Unmodified-Since"sv, "If-Range"sv, "Range"sv }) {
+        if (request_headers.contains(header))
+            return false;
+    }
+
+    return true;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool DiskCache::is_storable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // - the request method is understood by the cache;
+    if (method != "GET"sv)
+        return false;
+
+    // - the response status code is final;
+    if (status_code < 200)
+        return false;
+
+    // NOTE: We don't store partial content, nor validate responses to conditional requests we didn't make ourselves.
+    if (status_code == 206 || status_code == 304 || request_headers.contains("Range"sv))
+        return false;
+
+    // - the no-store cache directive is not present in the response or the request;
+    if (has_cache_control_directive(request_headers, "no-store"sv) || has_cache_control_directive(response_headers, "no-store"sv))
+        return false;
+
+    // - if the cache is shared: ...
+    // NOTE: This is a private cache, so the private and Authorization restrictions for shared caches don't apply.
+    //       We still don't store authenticated responses, since they're not partitioned by credentials here.
+    if (request_headers.contains("Authorization"sv))
+        return false;
+
+    // NOTE: Stored responses are not keyed by the request headers nominated by Vary. Accept-Encoding is the exception,
+    //       since it is always chosen by curl.
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto field_name : vary->split_view(',')) {
+            if (!field_name.trim_whitespace().equals_ignoring_ascii_case("Accept-Encoding"sv))
+                return false;
+        }
+    }
+
+    // NOTE: Replaying cookies from a stored response would undo changes that were made to them since.
+    if (response_headers.contains("Set-Cookie"sv))
+        return false;
+
+    // - the response contains at least one of the following:
+    //   + a public response directive;
+    //   + a private response directive, if the cache is not shared;
+    //   + an Expires header field;
+    //   + a max-age response directive;
+    //   + a cache extension that allows it to be cached;
+    //   + a status code that is defined as heuristically cacheable.
+    return has_cache_control_directive(response_headers, "public"sv)
+        || has_cache_control_directive(response_headers, "private"sv)
+        || response_headers.contains("Expires"sv)
+        || has_cache_control_directive(response_headers, "max-age"sv)
+        || is_heuristically_cacheable_status(status_code);
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create(LexicalPath directory, u64 maximum_size)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    // NOTE: Another instance would see its files being deleted as unreferenced, and vice versa, so the directory is
+    //       locked for the lifetime of the cache. The lock goes away with the process if it doesn't exit cleanly.
+    auto lock_fd = TRY(Core::System::open(directory.append(lock_file_name).string(), O_RDWR | O_CREAT | O_CLOEXEC, 0600));
+    struct flock lock {};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    if (auto result = Core::System::fcntl(lock_fd, F_SETLK, &lock); result.is_error()) {
+        (void)Core::System::close(lock_fd);
+        if (result.error().code() == EACCES || result.error().code() == EAGAIN)
+            return Error::from_string_literal("Cache directory is in use by another process");
+        return result.release_error();
+    }
+
+    auto cache = adopt_own(*new DiskCache(move(directory), maximum_size, lock_fd));
+    if (auto result = cache->read_index(); result.is_error()) {
+        dbgln("DiskCache: Unable to read the cache index, starting out empty: {}", result.error());
+        cache->m_lru_list.clear();
+        cache->m_entries.clear();
+        cache->m_current_size = 0;
+    }
+
+    TRY(cache->delete_unreferenced_files());
+    return cache;
+}
+
+DiskCache::DiskCache(LexicalPath directory, u64 maximum_size, int lock_fd)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+    , m_lock_fd(lock_fd)
+{
+    m_index_write_timer = Core::Timer::create_single_shot(index_write_delay_ms, [this] {
+        if (auto result = write_index_if_needed(); result.is_error())
+            dbgln("DiskCache: Unable to write the cache index: {}", result.error());
+    });
+}
+
+DiskCache::~DiskCache()
+{
+    // NOTE: Entries are unlinked from the LRU list as they're destroyed.
+    m_lru_list.clear();
+
+    (void)Core::System::close(m_lock_fd);
+}
+
+// NOTE: Bodies of entries that were never committed, or that were dropped from the index, would otherwise be leaked.
+//       This is only safe because no other instance can be writing to the directory at the same time.
+ErrorOr<void> DiskCache::delete_unreferenced_files()
+{
+    HashTable<ByteString> referenced_files;
+    referenced_files.set(index_file_name);
+    referenced_files.set(lock_file_name);
+    for (auto const& it : m_entries)
+        referenced_files.set(it.value->body_file_name);
+
+    Vector<ByteString> unreferenced_files;
+    TRY(Core::Directory::for_each_entry(m_directory.string(), Core::DirIterator::SkipParentAndBaseDir, [&](auto const& directory_entry, auto const&) -> ErrorOr<IterationDecision> {
+        if (directory_entry.type == Core::DirectoryEntry::Type::File && !referenced_files.contains(directory_entry.name))
+            unreferenced_files.append(directory_entry.name);
+        return IterationDecision::Continue;
+    }));
+
+    for (auto const& file_name : unreferenced_files)
+        (void)Core::System::unlink(path_for(file_name));
+    return {};
+}
+
+ByteString DiskCache::path_for(StringView file_name) const
+{
+    return m_directory.append(file_name).string();
+}
+
+Optional<DiskCache::Lookup> DiskCache::lookup(ByteString const& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+
+    auto& entry = *it->value;
+    touch_entry(entry);
+
+    // https://httpwg.org/specs/rfc9111.html#expiration.model
+    // A response's freshness lifetime ... The response is fresh if its age hasn't yet exceeded it.
+    // https://httpwg.org/specs/rfc9111.html#cache-response-directive.no-cache
+    auto freshness = Freshness::Stale;
+    if (!has_cache_control_directive(entry.response_headers, "no-cache"sv) && freshness_lifetime(entry) > current_age(entry, UnixDateTime::now()))
+        freshness = Freshness::Fresh;
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Found {} entry for {}", freshness == Freshness::Fresh ? "fresh"sv : "stale"sv, key);
+    return Lookup { entry, freshness };
+}
+
+Optional<DiskCache::Entry&> DiskCache::entry_for(ByteString const& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+    return *it->value;
+}
+
+ErrorOr<NonnullOwnPtr<Core::File>> DiskCache::open_body(Entry const& entry)
+{
+    return Core::File::open(path_for(entry.body_file_name), Core::File::OpenMode::Read);
+}
+
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+bool DiskCache::add_validation_headers(Entry const& entry, HTTP::HeaderMap& request_headers)
+{
+    auto etag = entry.response_headers.get("ETag"sv);
+    auto last_modified = entry.response_headers.get("Last-Modified"sv);
+    if (!etag.has_value() && !last_modified.has_value())
+        return false;
+
+    if (etag.has_value())
+        request_headers.set("If-None-Match"sv, *etag);
+    if (last_modified.has_value())
+        request_headers.set("If-Modified-Since"sv, *last_modified);
+    return true;
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+void DiskCache::freshen_entry_upon_validation(Entry& entry, HTTP::HeaderMap const& response_headers, UnixDateTime request_time)
+{
+    // The cache MUST use other header fields provided in the 304 (Not Modified) response to replace all instances of
+    // the corresponding header fields in the stored response.
+    HTTP::HeaderMap freshened_headers;
+    for (auto const& header : entry.response_headers.headers()) {
+        if (!response_headers.contains(header.name))
+            freshened_headers.set(header.name, header.value);
+    }
+    for (auto const& header : response_headers.headers()) {
+        // https://httpwg.org/specs/rfc9111.html#update
+        // Content-Length describes the (absent) body of the 304 response, not the stored one.
+        if (header.name.equals_ignoring_ascii_case("Content-Length"sv))
+            continue;
+        freshened_headers.set(header.name, header.value);
+    }
+
+    entry.response_headers = move(freshened_headers);
+    entry.request_time = request_time;
+    entry.response_time = UnixDateTime::now();
+    touch_entry(entry);
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Validated entry for {}", entry.key);
+    schedule_index_write();
+}
+
+void DiskCache::remove_entry(ByteString const& key)
+{
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return;
+
+    m_lru_list.remove(**entry);
+    m_current_size -= (*entry)->body_size;
+    delete_body_file(**entry);
+    schedule_index_write();
+}
+
+void DiskCache::insert_entry(NonnullOwnPtr<Entry> entry)
+{
+    remove_entry(entry->key);
+
+    m_current_size += entry->body_size;
+    m_lru_list.append(*entry);
+
+    auto key = entry->key;
+    m_entries.set(move(key), move(entry));
+}
+
+void DiskCache::touch_entry(Entry& entry)
+{
+    entry.last_access_time = UnixDateTime::now();
+
+    // NOTE: Re-appending an entry moves it to the most recently used end of the list.
+    m_lru_list.append(entry);
+
+    // OPTIMIZATION: Losing the order of use in a crash only makes eviction less accurate, so it's not worth rewriting
+    //               the index for. It is written along with the next actual change, or when the cache goes away.
+    m_lru_order_is_dirty = true;
+}
+
+void DiskCache::evict_entries_if_needed()
+{
+    while (m_current_size > m_maximum_size && !m_lru_list.is_empty()) {
+        auto key = m_lru_list.first()->key;
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Evicting entry for {}", key);
+        remove_entry(key);
+    }
+}
+
+void DiskCache::delete_body_file(Entry const& entry)
+{
+    if (auto result = Core::System::unlink(path_for(entry.body_file_name)); result.is_error())
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Unable to delete body file for {}: {}", entry.key, result.error());
+}
+
+OwnPtr<DiskCache::EntryWriter> DiskCache::create_entry_writer(ByteString key, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap response_headers, UnixDateTime request_time)
+{
+    auto entry = make<Entry>();
+    entry->body_file_name = body_file_name_for(key);
+    entry->key = move(key);
+    entry->status_code = status_code;
+    entry->reason_phrase = move(reason_phrase);
+    entry->response_headers = move(response_headers);
+    entry->request_time = request_time;
+    entry->response_time = UnixDateTime::now();
+    entry->last_access_time = entry->response_time;
+
+    // NOTE: The body is written to a temporary file first, so that an entry that is still being stored (or an older
+    //       version of it) is never observed with a partial body. Every writer gets a file of its own, since there
+    //       may be several requests for the same resource in flight at once.
+    ByteString temporary_path;
+    auto body_file = [&]() -> ErrorOr<NonnullOwnPtr<Core::File>> {
+        auto path_template = TRY(ByteBuffer::copy(path_for(ByteString::formatted("{}.tmp.XXXXXX", entry->body_file_name)).bytes()));
+        TRY(path_template.try_append('\0'));
+        auto fd = TRY(Core::System::mkstemp(path_template.span()));
+        temporary_path = ByteString { path_template.bytes().trim(path_template.size() - 1) };
+        return Core::File::adopt_fd(fd, Core::File::OpenMode::Write);
+    }();
+    if (body_file.is_error()) {
+        dbgln("DiskCache: Unable to create body file for {}: {}", entry->key, body_file.error());
+        return nullptr;
+    }
+
+    return adopt_own(*new EntryWriter(*this, move(entry), body_file.release_value(), move(temporary_path)));
+}
+
+DiskCache::EntryWriter::EntryWriter(DiskCache& cache, NonnullOwnPtr<Entry> entry, NonnullOwnPtr<Core::File> body_file, ByteString temporary_path)
+    : m_cache(cache)
+    , m_entry(move(entry))
+    , m_body_file(move(body_file))
+    , m_temporary_path(move(temporary_path))
+{
+}
+
+DiskCache::EntryWriter::~EntryWriter()
+{
+    // NOTE: If the entry was never committed, the response didn't arrive in full and must not be stored.
+    if (m_body_file) {
+        m_body_file = nullptr;
+        (void)Core::System::unlink(m_temporary_path);
+    }
+}
+
+void DiskCache::EntryWriter::append(ReadonlyBytes bytes)
+{
+    if (m_failed)
+        return;
+
+    if (auto result = m_body_file->write_until_depleted(bytes); result.is_error()) {
+        dbgln("DiskCache: Unable to write body of {}: {}", m_entry->key, result.error());
+        m_failed = true;
+        return;
+    }
+
+    m_entry->body_size += bytes.size();
+
+    // NOTE: There's no point in continuing to store a response that won't fit into the cache anyway.
+    if (m_entry->body_size > m_cache.m_maximum_size)
+        m_failed = true;
+}
+
+void DiskCache::EntryWriter::commit()
+{
+    VERIFY(m_body_file);
+    if (m_failed)
+        return;
+
+    m_body_file->close();
+    m_body_file = nullptr;
+
+    auto const& temporary_path = m_temporary_path;
+    auto final_path = m_cache.path_for(m_entry->body_file_name);
+
+    // NOTE: The old entry is removed first, since it shares its body file name with the new one.
+    auto key = m_entry->key;
+    m_cache.remove_entry(key);
+
+    if (auto result = Core::System::rename(temporary_path, final_path); result.is_error()) {
+        dbgln("DiskCache: Unable to store body of {}: {}", key, result.error());
+        (void)Core::System::unlink(temporary_path);
+        return;
+    }
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Stored {} bytes for {}", m_entry->body_size, key);
+
+    m_cache.insert_entry(m_entry.release_nonnull());
+    m_cache.evict_entries_if_needed();
+    m_cache.schedule_index_write();
+}
+
+void DiskCache::schedule_index_write()
+{
+    m_index_is_dirty = true;
+    if (!m_index_write_timer->is_active())
+        m_index_write_timer->start();
+}
+
+ErrorOr<void> DiskCache::write_index_if_needed()
+{
+    if (!m_index_is_dirty)
+        return {};
+    return write_index();
+}
+
+ErrorOr<void> DiskCache::flush_index()
+{
+    m_index_write_timer->stop();
+    if (!m_index_is_dirty && !m_lru_order_is_dirty)
+        return {};
+    return write_index();
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(Stream& stream)
+{
+    auto length = TRY(stream.read_value<LittleEndian<u32>>());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return ByteString { buffer.bytes() };
+}
+
+static ErrorOr<void> write_time(Stream& stream, UnixDateTime time)
+{
+    return stream.write_value<LittleEndian<i64>>(time.milliseconds_since_epoch());
+}
+
+static ErrorOr<UnixDateTime> read_time(Stream& stream)
+{
+    return UnixDateTime::from_milliseconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+}
+
+ErrorOr<void> DiskCache::write_index()
+{
+    m_index_is_dirty = false;
+    m_lru_order_is_dirty = false;
+
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value<LittleEndian<u32>>(index_magic));
+    TRY(stream.write_value<LittleEndian<u32>>(index_version));
+    TRY(stream.write_value<LittleEndian<u32>>(m_entries.size()));
+
+    // NOTE: Entries are written in LRU order, so that the order survives a restart.
+    for (auto const& entry : m_lru_list) {
+        TRY(write_string(stream, entry.key));
+        TRY(write_string(stream, entry.body_file_name));
+        TRY(stream.write_value<LittleEndian<u32>>(entry.status_code));
+        TRY(stream.write_value<u8>(entry.reason_phrase.has_value()));
+        if (entry.reason_phrase.has_value())
+            TRY(write_string(stream, *entry.reason_phrase));
+        TRY(stream.write_value<LittleEndian<u32>>(entry.response_headers.headers().size()));
+        for (auto const& header : entry.response_headers.headers()) {
+            TRY(write_string(stream, header.name));
+            TRY(write_string(stream, header.value));
+        }
+        TRY(write_time(stream, entry.request_time));
+        TRY(write_time(stream, entry.response_time));
+        TRY(write_time(stream, entry.last_access_time));
+        TRY(stream.write_value<LittleEndian<u64>>(entry.body_size));
+    }
+
+    auto index = TRY(stream.read_until_eof());
+
+    // NOTE: The index is replaced atomically, so that a crash while writing it doesn't lose the whole cache.
+    auto temporary_path = path_for(ByteString::formatted("{}.tmp", index_file_name));
+    auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_until_depleted(index));
+    file->close();
+    TRY(Core::System::rename(temporary_path, path_for(index_file_name)));
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Wrote index with {} entries ({} bytes of bodies)", m_entries.size(), m_current_size);
+    return {};
+}
+
+ErrorOr<void> DiskCache::read_index()
+{
+    auto file_or_error = Core::File::open(path_for(index_file_name), Core::File::OpenMode::Read);
+    if (file_or_error.is_error()) {
+        if (file_or_error.error().is_errno() && file_or_error.error().code() == ENOENT)
+            return {};
+        return file_or_error.release_error();
+    }
+
+    auto index = TRY(file_or_error.value()->read_until_eof());
+    FixedMemoryStream stream { index.bytes() };
+
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != index_magic)
+        return Error::from_string_literal("Invalid index file");
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != index_version)
+        return Error::from_string_literal("Unsupported index file version");
+
+    auto entry_count = TRY(stream.read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < entry_count; ++i) {
+        auto entry = make<Entry>();
+        entry->key = TRY(read_string(stream));
+        entry->body_file_name = TRY(read_string(stream));
+        entry->status_code = TRY(stream.read_value<LittleEndian<u32>>());
+        if (TRY(stream.read_value<u8>()) != 0)
+            entry->reason_phrase = TRY(String::from_byte_string(TRY(read_string(stream))));
+        auto header_count = TRY(stream.read_value<LittleEndian<u32>>());
+        for (u32 j = 0; j < header_count; ++j) {
+            auto name = TRY(read_string(stream));
+            auto value = TRY(read_string(stream));
+            entry->response_headers.set(move(name), move(value));
+        }
+        entry->request_time = TRY(read_time(stream));
+        entry->response_time = TRY(read_time(stream));
+        entry->last_access_time = TRY(read_time(stream));
+        entry->body_size = TRY(stream.read_value<LittleEndian<u64>>());
+
+        // NOTE: Body files may have been deleted behind our back.
+        if (auto result = Core::System::stat(path_for(entry->body_file_name)); result.is_error() || static_cast<u64>(result.value().st_size) != entry->body_size)
+            continue;
+
+        insert_entry(move(entry));
+    }
+
+    m_index_is_dirty = false;
+    m_lru_order_is_dirty = false;
+    evict_entries_if_needed();
+    return {};
+}
+
+}
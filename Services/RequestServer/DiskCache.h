@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/LexicalPath.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <LibCore/Forward.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// A persistent HTTP cache (https://httpwg.org/specs/rfc9111.html) that is shared by all clients of RequestServer.
+// Response bodies are stored in one file per response, and everything else is kept in an index file that is loaded
+// into memory on startup. Entries are evicted in least-recently-used order once the cache grows beyond its budget.
+// The cache directory is locked for as long as the cache exists, so only one RequestServer can use it at a time.
+class DiskCache {
+    AK_MAKE_NONCOPYABLE(DiskCache);
+    AK_MAKE_NONMOVABLE(DiskCache);
+
+public:
+    static constexpr u64 default_maximum_size = 256 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create(LexicalPath directory, u64 maximum_size = default_maximum_size);
+    ~DiskCache();
+
+    struct Entry {
+        ByteString key;
+        ByteString body_file_name;
+        u32 status_code { 0 };
+        Optional<String> reason_phrase;
+        HTTP::HeaderMap response_headers;
+        UnixDateTime request_time;
+        UnixDateTime response_time;
+        UnixDateTime last_access_time;
+        u64 body_size { 0 };
+
+        IntrusiveListNode<Entry> lru_list_node;
+    };
+
+    // https://fetch.spec.whatwg.org/#determine-the-http-cache-partition
+    // The partition is the serialized network partition key of the request, as determined by the client. Requests
+    // without a partition are never cached, just like in the in-memory cache of LibWeb.
+    static Optional<ByteString> cache_key_for(StringView method, URL::URL const&, Optional<ByteString> const& partition);
+    static bool can_use_stored_response(HTTP::HeaderMap const& request_headers);
+
+    enum class Freshness {
+        Fresh,
+        Stale,
+    };
+    struct Lookup {
+        Entry& entry;
+        Freshness freshness;
+    };
+    Optional<Lookup> lookup(ByteString const& key);
+    Optional<Entry&> entry_for(ByteString const& key);
+
+    ErrorOr<NonnullOwnPtr<Core::File>> open_body(Entry const&);
+
+    // Adds the validators of a stale entry to the request headers, so that the server can answer with a 304.
+    // Returns false if the entry can't be validated, in which case it should just be fetched again.
+    static bool add_validation_headers(Entry const&, HTTP::HeaderMap& request_headers);
+
+    // https://httpwg.org/specs/rfc9111.html#freshening.responses
+    void freshen_entry_upon_validation(Entry&, HTTP::HeaderMap const& response_headers, UnixDateTime request_time);
+
+    void remove_entry(ByteString const& key);
+
+    // Receives the body of a response from the network, and stores it in the cache once it has been fully received.
+    class EntryWriter {
+    public:
+        ~EntryWriter();
+
+        void append(ReadonlyBytes);
+        void commit();
+
+    private:
+        friend class DiskCache;
+        EntryWriter(DiskCache&, NonnullOwnPtr<Entry>, NonnullOwnPtr<Core::File>, ByteString temporary_path);
+
+        DiskCache& m_cache;
+        OwnPtr<Entry> m_entry;
+        OwnPtr<Core::File> m_body_file;
+        ByteString m_temporary_path;
+        bool m_failed { false };
+    };
+
+    static bool is_storable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers);
+    OwnPtr<EntryWriter> create_entry_writer(ByteString key, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap response_headers, UnixDateTime request_time);
+
+    // Writes out the index if anything changed since it was last written, including the order of use of the entries,
+    // which on its own is not worth writing the index for until the cache goes away.
+    ErrorOr<void> flush_index();
+
+    u64 current_size() const { return m_current_size; }
+
+private:
+    DiskCache(LexicalPath directory, u64 maximum_size, int lock_fd);
+
+    ErrorOr<void> write_index_if_needed();
+
+    ErrorOr<void> read_index();
+    ErrorOr<void> write_index();
+    ErrorOr<void> delete_unreferenced_files();
+    void schedule_index_write();
+
+    ByteString path_for(StringView file_name) const;
+
+    void insert_entry(NonnullOwnPtr<Entry>);
+    void touch_entry(Entry&);
+    void evict_entries_if_needed();
+    void delete_body_file(Entry const&);
+
+    LexicalPath m_directory;
+    u64 m_maximum_size { 0 };
+    u64 m_current_size { 0 };
+
+    HashMap<ByteString, NonnullOwnPtr<Entry>> m_entries;
+    IntrusiveList<&Entry::lru_list_node> m_lru_list;
+
+    int m_lock_fd { -1 };
+
+    RefPtr<Core::Timer> m_index_write_timer;
+    bool m_index_is_dirty { false };
+    bool m_lru_order_is_dirty { false };
+};
+
+extern OwnPtr<DiskCache> g_disk_cache;
+
+}
@@ -11,12 +11,14 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/TLSv12.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 
 #if defined(AK_OS_MACOS)
 #    include <LibCore/Platform/ProcessStatisticsMach.h>
@@ -44,12 +46,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    bool enable_http_disk_cache = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(enable_http_disk_cache, "Enable HTTP disk cache", "enable-http-disk-cache");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
@@ -63,6 +67,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Core::EventLoop event_loop;
 
+    if (enable_http_disk_cache) {
+        auto cache_directory = LexicalPath::join(Core::StandardPaths::cache_directory(), "Ladybird"sv, "HTTPCache"sv);
+        if (auto disk_cache = RequestServer::DiskCache::create(move(cache_directory)); disk_cache.is_error())
+            warnln("Unable to create HTTP disk cache: {}", disk_cache.error());
+        else
+            RequestServer::g_disk_cache = disk_cache.release_value();
+    }
+
 #if defined(AK_OS_MACOS)
     if (!mach_server_name.is_empty())
         Core::Platform::register_with_mach_server(mach_server_name);
@@ -70,5 +82,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<RequestServer::ConnectionFromClient>());
 
-    return event_loop.exec();
+    auto exit_code = event_loop.exec();
+
+    if (RequestServer::g_disk_cache) {
+        if (auto result = RequestServer::g_disk_cache->flush_index(); result.is_error())
+            warnln("Unable to write HTTP disk cache index: {}", result.error());
+        RequestServer::g_disk_cache = nullptr;
+    }
+
+    return exit_code;
 }
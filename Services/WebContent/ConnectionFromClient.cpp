@@ -60,6 +60,8 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     : IPC::ConnectionFromClient<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(transport), 1)
     , m_page_host(PageHost::create(*this))
 {
+    // OPTIMIZATION: We send the UI large messages like page source, DOM trees and screenshots.
+    this->transport().enable_shared_memory_for_large_messages();
 }
 
 ConnectionFromClient::~ConnectionFromClient() = default;
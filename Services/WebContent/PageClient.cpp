@@ -231,12 +231,17 @@ void PageClient::paint_next_frame()
     m_number_of_queued_rasterization_tasks++;
 
     auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-    start_display_list_rendering(viewport_rect, *back_store, {}, [this, viewport_rect, backing_store_id] {
+    start_display_list_rendering(viewport_rect, *back_store, {}, OnlyRepaintDamagedRect::Yes, [this, viewport_rect, backing_store_id] {
         client().async_did_paint(m_id, viewport_rect.to_type<int>(), backing_store_id);
     });
 }
 
 void PageClient::start_display_list_rendering(Web::DevicePixelRect const& content_rect, Web::Painting::BackingStore& target, Web::PaintOptions paint_options, Function<void()>&& callback)
+{
+    start_display_list_rendering(content_rect, target, paint_options, OnlyRepaintDamagedRect::No, move(callback));
+}
+
+void PageClient::start_display_list_rendering(Web::DevicePixelRect const& content_rect, Web::Painting::BackingStore& target, Web::PaintOptions paint_options, OnlyRepaintDamagedRect only_repaint_damaged_rect, Function<void()>&& callback)
 {
     paint_options.should_show_line_box_borders = m_should_show_line_box_borders;
     paint_options.has_focus = m_has_focus;
@@ -246,7 +251,13 @@ void PageClient::start_display_list_rendering(Web::DevicePixelRect const& conten
         callback();
         return;
     }
-    traversable.start_display_list_rendering(*display_list, target, move(callback));
+
+    // NOTE: Recording the display list updates style and layout, which may damage more of the viewport. If nothing was
+    //       recorded, the damage is kept for the next frame.
+    Optional<Web::DevicePixelRect> damaged_rect;
+    if (only_repaint_damaged_rect == OnlyRepaintDamagedRect::Yes)
+        damaged_rect = traversable.take_damaged_rect(content_rect.size());
+    traversable.start_display_list_rendering(*display_list, target, damaged_rect, move(callback));
 }
 
 Queue<Web::QueuedInputEvent>& PageClient::input_event_queue()
@@ -107,6 +107,12 @@ private:
 
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    enum class OnlyRepaintDamagedRect {
+        No,
+        Yes,
+    };
+    void start_display_list_rendering(Web::DevicePixelRect const& content_rect, Web::Painting::BackingStore&, Web::PaintOptions, OnlyRepaintDamagedRect, Function<void()>&& callback);
+
     // ^PageClient
     virtual bool is_connection_open() const override;
     virtual bool is_url_suitable_for_same_process_navigation(URL::URL const& current_url, URL::URL const& target_url) const override;
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibTest/TestCase.h>
+
+class SmallCell final : public GC::Cell {
+    GC_CELL(SmallCell, GC::Cell);
+
+public:
+    explicit SmallCell(u32 value)
+        : m_value(value)
+    {
+    }
+
+    u32 value() const { return m_value; }
+
+private:
+    u32 m_value { 0 };
+};
+
+static GC::Heap& heap()
+{
+    static GC::Heap heap(nullptr, [](auto&) { });
+    return heap;
+}
+
+TEST_CASE(allocated_cells_are_constructed)
+{
+    auto cell = heap().allocate<SmallCell>(42u);
+    EXPECT_EQ(cell->value(), 42u);
+    EXPECT_EQ(cell->state(), GC::Cell::State::Live);
+}
+
+BENCHMARK_CASE(allocate_10m_small_cells)
+{
+    u64 sum = 0;
+    for (u32 i = 0; i < 10'000'000; ++i)
+        sum += heap().allocate<SmallCell>(i)->value();
+    EXPECT_EQ(sum, 49999995000000ull);
+}
@@ -292,6 +292,29 @@ TEST_CASE(test_jpeg_rgb_components)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 592, 800 }));
 }
 
+TEST_CASE(test_jpeg_decode_to_ideal_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 140, 190 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
+TEST_CASE(test_jpeg_partial_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto partial_data = file->bytes().slice(0, file->bytes().size() / 2);
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(partial_data));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->partial_frame());
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
 TEST_CASE(test_jpeg_ycck)
 {
     Array test_inputs = {
@@ -405,6 +428,34 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_decode_to_ideal_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 16, 34 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(16, 35));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(64, 138));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(64, 138));
+}
+
+TEST_CASE(test_png_partial_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto complete_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_decoder->frame(0));
+
+    auto partial_data = file->bytes().slice(0, file->bytes().size() / 2);
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(partial_data));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->partial_frame());
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(64, 138));
+    EXPECT_EQ(frame.image->get_pixel(32, 0), complete_frame.image->get_pixel(32, 0));
+    EXPECT_EQ(frame.image->get_pixel(32, 137), Gfx::Color::NamedColor::Transparent);
+}
+
 TEST_CASE(test_apng)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/apng-1-frame.png"sv)));
@@ -765,6 +816,19 @@ TEST_CASE(test_webp_simple_lossy)
     EXPECT_EQ(frame.image->get_pixel(198, 202), Gfx::Color(0x7a, 0xaa, 0xd5, 255));
 }
 
+TEST_CASE(test_webp_decode_to_ideal_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8.webp"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 60, 60 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(60, 60));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(240, 240));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(240, 240));
+}
+
 TEST_CASE(test_webp_simple_lossless)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8l.webp"sv)));
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/SharedMemoryRing.h>
+#include <LibIPC/TransportSocket.h>
+#include <LibTest/TestCase.h>
+
+enum class UseSharedMemory {
+    No,
+    Yes,
+};
+
+struct TransportPair {
+    NonnullOwnPtr<IPC::TransportSocket> sender;
+    NonnullOwnPtr<IPC::TransportSocket> receiver;
+};
+
+static TransportPair create_transport_pair(UseSharedMemory use_shared_memory)
+{
+    int socket_fds[2] {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, socket_fds));
+
+    auto sender = make<IPC::TransportSocket>(MUST(Core::LocalSocket::adopt_fd(socket_fds[0])));
+    auto receiver = make<IPC::TransportSocket>(MUST(Core::LocalSocket::adopt_fd(socket_fds[1])));
+
+    if (use_shared_memory == UseSharedMemory::Yes) {
+        sender->enable_shared_memory_for_large_messages();
+        receiver->enable_shared_memory_for_large_messages();
+    }
+
+    return { move(sender), move(receiver) };
+}
+
+struct ReceivedMessage {
+    Vector<u8> bytes;
+    Vector<IPC::File> fds;
+};
+
+static Vector<ReceivedMessage> receive_messages(IPC::TransportSocket& transport, size_t count)
+{
+    Vector<ReceivedMessage> messages;
+    while (messages.size() < count) {
+        transport.wait_until_readable();
+        auto should_shutdown = transport.read_as_many_messages_as_possible_without_blocking([&](auto&& message) {
+            ReceivedMessage received_message { .bytes = move(message.bytes), .fds = {} };
+            while (!message.fds.is_empty())
+                received_message.fds.append(message.fds.dequeue());
+            messages.append(move(received_message));
+        });
+        VERIFY(should_shutdown == IPC::TransportSocket::ShouldShutdown::No);
+    }
+    return messages;
+}
+
+static Vector<u8> make_message(size_t size, u8 seed)
+{
+    Vector<u8> message;
+    message.resize(size);
+    for (size_t i = 0; i < size; ++i)
+        message[i] = static_cast<u8>(seed + i * 7);
+    return message;
+}
+
+TEST_CASE(small_and_large_messages_arrive_in_order)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair(UseSharedMemory::Yes);
+
+    // NOTE: The last message doesn't fit into the ring, and has to go through the socket instead.
+    Array sizes { 16uz, 64 * KiB, 100uz, 512 * KiB, IPC::TransportSocket::SHARED_MEMORY_MESSAGE_THRESHOLD, 1uz, IPC::SharedMemoryRing::default_capacity + 1 };
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+        sender->post_message(make_message(sizes[i], static_cast<u8>(i)), {});
+
+    auto messages = receive_messages(*receiver, sizes.size());
+    EXPECT_EQ(messages.size(), sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i)
+        EXPECT_EQ(messages[i].bytes, make_message(sizes[i], static_cast<u8>(i)));
+}
+
+TEST_CASE(ring_wraps_around)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair(UseSharedMemory::Yes);
+
+    // NOTE: Wait for each message so that the ring never fills up, and the messages end up straddling its end.
+    auto message_size = IPC::SharedMemoryRing::default_capacity / 3;
+    for (size_t i = 0; i < 10; ++i) {
+        sender->post_message(make_message(message_size, static_cast<u8>(i)), {});
+        auto messages = receive_messages(*receiver, 1);
+        EXPECT_EQ(messages.first().bytes, make_message(message_size, static_cast<u8>(i)));
+    }
+}
+
+TEST_CASE(file_descriptors_are_sent_with_large_messages)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair(UseSharedMemory::Yes);
+
+    auto pipe_fds = MUST(Core::System::pipe2(O_CLOEXEC));
+    MUST(Core::System::write(pipe_fds[1], "hello"sv.bytes()));
+    MUST(Core::System::close(pipe_fds[1]));
+
+    Vector<NonnullRefPtr<IPC::AutoCloseFileDescriptor>> fds;
+    fds.append(adopt_ref(*new IPC::AutoCloseFileDescriptor(pipe_fds[0])));
+    sender->post_message(make_message(128 * KiB, 0), fds);
+
+    auto messages = receive_messages(*receiver, 1);
+    EXPECT_EQ(messages.first().bytes, make_message(128 * KiB, 0));
+    EXPECT_EQ(messages.first().fds.size(), 1u);
+
+    auto file = messages.first().fds.take_first();
+    char buffer[5] {};
+    EXPECT_EQ(MUST(Core::System::read(file.fd(), { buffer, sizeof(buffer) })), 5uz);
+    EXPECT_EQ(StringView(buffer, sizeof(buffer)), "hello"sv);
+}
+
+static void measure_round_trips(UseSharedMemory use_shared_memory, size_t message_size, size_t round_trips)
+{
+    Core::EventLoop loop;
+    auto [client, server] = create_transport_pair(use_shared_memory);
+    auto message = make_message(message_size, 0);
+
+    for (size_t i = 0; i < round_trips; ++i) {
+        client->post_message(message, {});
+        auto requests = receive_messages(*server, 1);
+        server->post_message(requests.first().bytes, {});
+        (void)receive_messages(*client, 1);
+    }
+}
+
+static void measure_throughput(UseSharedMemory use_shared_memory, size_t message_size, size_t message_count)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair(use_shared_memory);
+    auto message = make_message(message_size, 0);
+
+    // NOTE: Send in batches, so that the ring has a chance to be drained before it fills up.
+    static constexpr size_t batch_size = 2;
+    for (size_t i = 0; i < message_count; i += batch_size) {
+        for (size_t j = 0; j < batch_size; ++j)
+            sender->post_message(message, {});
+        (void)receive_messages(*receiver, batch_size);
+    }
+}
+
+BENCHMARK_CASE(round_trip_latency_small_messages)
+{
+    measure_round_trips(UseSharedMemory::No, 64, 10'000);
+}
+
+BENCHMARK_CASE(round_trip_latency_large_messages_through_socket)
+{
+    measure_round_trips(UseSharedMemory::No, 256 * KiB, 1'000);
+}
+
+BENCHMARK_CASE(round_trip_latency_large_messages_through_shared_memory)
+{
+    measure_round_trips(UseSharedMemory::Yes, 256 * KiB, 1'000);
+}
+
+BENCHMARK_CASE(throughput_large_messages_through_socket)
+{
+    measure_throughput(UseSharedMemory::No, 256 * KiB, 4'000);
+}
+
+BENCHMARK_CASE(throughput_large_messages_through_shared_memory)
+{
+    measure_throughput(UseSharedMemory::Yes, 256 * KiB, 4'000);
+}
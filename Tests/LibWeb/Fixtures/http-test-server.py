@@ -6,6 +6,7 @@ import os
 import socketserver
 import sys
 import time
+import urllib.parse
 from typing import Dict, Optional
 
 """
@@ -15,6 +16,7 @@ Description:
 
 Endpoints:
     - POST /echo <json body>, Creates an echo response for later use. See "Echo" class below for body properties.
+    - GET /echo/request-count?method=<method>&path=<path>, Returns how many times an echo response has been requested.
 """
 
 
@@ -31,6 +33,9 @@ class Echo:
 # In-memory store for echo responses
 echo_store: Dict[str, Echo] = {}
 
+# Number of requests that have been made to each echo response
+echo_request_counts: Dict[str, int] = {}
+
 
 class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
     def __init__(self, *arguments, **kwargs):
@@ -41,6 +46,8 @@ class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
             # Remove "/static/" prefix and use built-in method
             self.path = self.path[7:]
             return super().do_GET()
+        elif self.path.startswith("/echo/request-count?"):
+            self.handle_echo_request_count()
         else:
             self.handle_echo()
 
@@ -123,6 +130,7 @@ class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
 
         if key in echo_store:
             echo = echo_store[key]
+            echo_request_counts[key] = echo_request_counts.get(key, 0) + 1
 
             if echo.delay_ms is not None:
                 time.sleep(echo.delay_ms / 1000)
@@ -141,6 +149,27 @@ class TestHTTPRequestHandler(http.server.SimpleHTTPRequestHandler):
         else:
             self.send_error(404, f"Echo response not found for {key}")
 
+    def handle_echo_request_count(self):
+        query = urllib.parse.parse_qs(urllib.parse.urlsplit(self.path).query)
+        method = query.get("method", [None])[0]
+        path = query.get("path", [None])[0]
+
+        # Return 400: Bad Request if the echo response is not specified
+        if method is None or path is None:
+            self.send_response(400)
+            self.send_header("Content-Type", "text/plain")
+            self.end_headers()
+            return
+
+        key = f"{method.upper()} {path}"
+
+        self.send_response(200)
+        self.send_header("Access-Control-Allow-Origin", "*")
+        self.send_header("Cache-Control", "no-store")
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({"count": echo_request_counts.get(key, 0)}).encode("utf-8"))
+
     def do_other(self):
         if self.path.startswith("/static/"):
             self.send_error(405, "Method Not Allowed")
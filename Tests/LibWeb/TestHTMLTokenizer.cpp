@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Array.h>
 #include <LibCore/File.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 
@@ -86,6 +87,28 @@ static Vector<Token> run_tokenizer(StringView input)
     return tokens;
 }
 
+static Vector<Token> run_tokenizer_on_chunks(ReadonlySpan<StringView> chunks)
+{
+    Vector<Token> tokens;
+    Tokenizer tokenizer;
+    tokenizer.open_input_stream();
+    auto take_available_tokens = [&] {
+        while (true) {
+            auto maybe_token = tokenizer.next_token();
+            if (!maybe_token.has_value())
+                break;
+            tokens.append(maybe_token.release_value());
+        }
+    };
+    for (auto chunk : chunks) {
+        tokenizer.append_to_input_stream(chunk);
+        take_available_tokens();
+    }
+    tokenizer.close_input_stream();
+    take_available_tokens();
+    return tokens;
+}
+
 // FIXME: It's not very nice to rely on the format of HTMLToken::to_string() to stay the same.
 static u32 hash_tokens(Vector<Token> const& tokens)
 {
@@ -161,6 +184,17 @@ TEST_CASE(double_quoted_attributes)
     END_ENUMERATION();
 }
 
+TEST_CASE(double_quoted_attribute_with_long_non_ascii_value)
+{
+    auto tokens = run_tokenizer("<p foo=\"h\u00e9llo w\u00f6rld, this is a long value\">"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 42u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(1);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(foo, "h\u00e9llo w\u00f6rld, this is a long value", 3u, 6u, 7u, 42u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(valueless_attribute)
 {
     auto tokens = run_tokenizer("<p foo>"sv);
@@ -238,6 +272,79 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html, 23u, 27u);
 }
 
+// Splits the input into two chunks at every byte offset, and checks that the tokens come out the same as for the whole input.
+static void expect_same_tokens_for_every_split(StringView input)
+{
+    auto expected_hash = hash_tokens(run_tokenizer_on_chunks(Array { input }));
+    for (size_t i = 0; i <= input.length(); ++i) {
+        auto tokens = run_tokenizer_on_chunks(Array { input.substring_view(0, i), input.substring_view(i) });
+        EXPECT_EQ(hash_tokens(tokens), expected_hash);
+    }
+}
+
+TEST_CASE(chunk_split_in_crlf)
+{
+    auto tokens = run_tokenizer_on_chunks(Array { "<p>a\r"sv, "\nb</p>"sv });
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    EXPECT_CHARACTER_TOKEN('a');
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKEN('b');
+    EXPECT_EQ(current_token->type(), Token::Type::EndTag);
+    NEXT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+
+    expect_same_tokens_for_every_split("<p title=\"a\r\nb\">a\r\n\r\rb</p>\r"sv);
+}
+
+TEST_CASE(chunk_split_in_character_reference)
+{
+    auto tokens = run_tokenizer_on_chunks(Array { "<p foo=\"a&no"sv, "t=b\" bar=\"&amp"sv, "\">"sv });
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::StartTag);
+    NEXT_TOKEN();
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(2);
+    EXPECT_EQ(last_token->raw_attribute("foo"_fly_string)->value, "a&not=b");
+    EXPECT_EQ(last_token->raw_attribute("bar"_fly_string)->value, "&");
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+
+    expect_same_tokens_for_every_split("<p foo=\"a&notin;b&notinx&amp=c&amp\" bar=&lt>&notit; &#x41;&#66&amp</p>"sv);
+}
+
+TEST_CASE(chunk_split_in_utf8_sequence)
+{
+    auto tokens = run_tokenizer_on_chunks(Array { "<p>\xE2\x82"sv, "\xAC</p>"sv });
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    EXPECT_CHARACTER_TOKEN(0x20AC);
+    EXPECT_EQ(current_token->type(), Token::Type::EndTag);
+    NEXT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+
+    expect_same_tokens_for_every_split("<p title=\"h\u00e9\u20ac\U0001F600\">\u00e9\u20ac\U0001F600</p>"sv);
+}
+
+TEST_CASE(consumed_source_length_skips_inserted_input)
+{
+    Tokenizer tokenizer { "<a><b>"sv, "UTF-8"sv };
+    EXPECT_EQ(tokenizer.next_token()->tag_name(), "a"_fly_string);
+    EXPECT_EQ(tokenizer.consumed_source_length(), 3u);
+
+    tokenizer.update_insertion_point();
+    tokenizer.insert_input_at_insertion_point("<i></i>"sv);
+    EXPECT_EQ(tokenizer.next_token()->tag_name(), "i"_fly_string);
+    EXPECT_EQ(tokenizer.consumed_source_length(), 3u);
+    EXPECT_EQ(tokenizer.next_token()->tag_name(), "i"_fly_string);
+    EXPECT_EQ(tokenizer.consumed_source_length(), 3u);
+
+    EXPECT_EQ(tokenizer.next_token()->tag_name(), "b"_fly_string);
+    EXPECT_EQ(tokenizer.consumed_source_length(), 6u);
+    EXPECT_EQ(tokenizer.source(), "<a><b>"sv);
+}
+
 // NOTE: This relies on the format of HTMLToken::to_string() staying the same.
 //       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
 TEST_CASE(regression)
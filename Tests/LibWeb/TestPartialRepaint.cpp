@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/BackingStoreDamageTracker.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/ScrollState.h>
+
+using Web::Painting::BackingStoreDamageTracker;
+
+static NonnullRefPtr<Gfx::Bitmap> create_bitmap()
+{
+    return MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 100, 100 }));
+}
+
+TEST_CASE(new_backing_store_is_repainted_entirely)
+{
+    BackingStoreDamageTracker tracker;
+    auto bitmap = create_bitmap();
+    tracker.did_create_backing_store(*bitmap);
+
+    EXPECT(!tracker.rect_to_repaint(*bitmap, Gfx::IntRect { 10, 10, 5, 5 }).has_value());
+}
+
+TEST_CASE(frame_without_damage_is_repainted_entirely)
+{
+    BackingStoreDamageTracker tracker;
+    auto bitmap = create_bitmap();
+    tracker.did_create_backing_store(*bitmap);
+    tracker.did_paint_frame(*bitmap, Gfx::IntRect { 0, 0, 100, 100 });
+
+    EXPECT(!tracker.rect_to_repaint(*bitmap, {}).has_value());
+}
+
+TEST_CASE(damage_of_frames_painted_into_other_backing_stores_is_repainted)
+{
+    BackingStoreDamageTracker tracker;
+    auto front = create_bitmap();
+    auto back = create_bitmap();
+    tracker.did_create_backing_store(*front);
+    tracker.did_create_backing_store(*back);
+    tracker.did_paint_frame(*front, Gfx::IntRect { 0, 0, 100, 100 });
+    tracker.did_paint_frame(*back, Gfx::IntRect { 0, 0, 100, 100 });
+
+    // The next frame goes into the front store, which has missed the frame that went into the back store.
+    tracker.did_paint_frame(*back, Gfx::IntRect { 10, 10, 10, 10 });
+    EXPECT_EQ(tracker.rect_to_repaint(*front, Gfx::IntRect { 50, 50, 10, 10 }), Gfx::IntRect(10, 10, 50, 50));
+    tracker.did_paint_frame(*front, Gfx::IntRect { 50, 50, 10, 10 });
+
+    // Now the front store is up to date, and the back store has missed the frame that went into the front store.
+    EXPECT_EQ(tracker.rect_to_repaint(*front, Gfx::IntRect { 0, 0, 5, 5 }), Gfx::IntRect(0, 0, 5, 5));
+    EXPECT_EQ(tracker.rect_to_repaint(*back, Gfx::IntRect { 0, 0, 5, 5 }), Gfx::IntRect(0, 0, 60, 60));
+}
+
+TEST_CASE(damage_is_clipped_to_backing_store)
+{
+    BackingStoreDamageTracker tracker;
+    auto bitmap = create_bitmap();
+    tracker.did_create_backing_store(*bitmap);
+    tracker.did_paint_frame(*bitmap, Gfx::IntRect { 0, 0, 100, 100 });
+
+    EXPECT_EQ(tracker.rect_to_repaint(*bitmap, Gfx::IntRect { 90, 90, 50, 50 }), Gfx::IntRect(90, 90, 10, 10));
+    EXPECT(!tracker.rect_to_repaint(*bitmap, Gfx::IntRect { -10, -10, 200, 200 }).has_value());
+}
+
+TEST_CASE(forgotten_backing_stores_are_repainted_entirely)
+{
+    BackingStoreDamageTracker tracker;
+    auto bitmap = create_bitmap();
+    tracker.did_create_backing_store(*bitmap);
+    tracker.did_paint_frame(*bitmap, Gfx::IntRect { 0, 0, 100, 100 });
+    tracker.did_forget_all_backing_stores();
+
+    EXPECT(!tracker.rect_to_repaint(*bitmap, Gfx::IntRect { 10, 10, 5, 5 }).has_value());
+}
+
+TEST_CASE(added_damage_is_repainted_next_time)
+{
+    BackingStoreDamageTracker tracker;
+    auto bitmap = create_bitmap();
+    tracker.did_create_backing_store(*bitmap);
+    tracker.did_paint_frame(*bitmap, Gfx::IntRect { 0, 0, 100, 100 });
+    tracker.add_damage(*bitmap, Gfx::IntRect { 20, 20, 10, 10 });
+
+    EXPECT_EQ(tracker.rect_to_repaint(*bitmap, Gfx::IntRect { 0, 0, 10, 10 }), Gfx::IntRect(0, 0, 30, 30));
+}
+
+TEST_CASE(only_damaged_rect_is_repainted)
+{
+    auto bitmap = create_bitmap();
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+    Web::Painting::DisplayListPlayerSkia player;
+
+    auto white = Web::Painting::DisplayList::create();
+    white->append(Web::Painting::FillRect { { 0, 0, 100, 100 }, Color::White }, {});
+    player.execute(*white, {}, surface);
+
+    auto red = Web::Painting::DisplayList::create();
+    red->append(Web::Painting::FillRect { { 0, 0, 100, 100 }, Color::Red }, {});
+    player.execute(*red, {}, surface, Gfx::IntRect { 10, 10, 20, 20 });
+
+    EXPECT_EQ(bitmap->get_pixel(15, 15), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(29, 29), Color(Color::Red));
+    EXPECT_EQ(bitmap->get_pixel(5, 5), Color(Color::White));
+    EXPECT_EQ(bitmap->get_pixel(30, 30), Color(Color::White));
+    EXPECT_EQ(bitmap->get_pixel(50, 50), Color(Color::White));
+}
@@ -119,6 +119,17 @@ class HTTPTestServer {
         }
         return `${this.baseURL}${path}`;
     }
+    getRequestCountURL(method, path) {
+        const query = new URLSearchParams({ method, path });
+        return `${this.baseURL}/echo/request-count?${query}`;
+    }
+    async getRequestCount(method, path) {
+        const result = await fetch(this.getRequestCountURL(method, path));
+        if (!result.ok) {
+            throw new Error("Error getting request count: " + result.statusText);
+        }
+        return (await result.json()).count;
+    }
     getStaticURL(path) {
         return `${this.baseURL}/static/${path}`;
     }
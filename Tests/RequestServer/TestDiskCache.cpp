@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <RequestServer/DiskCache.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using RequestServer::DiskCache;
+
+static HTTP::HeaderMap cacheable_response_headers()
+{
+    HTTP::HeaderMap headers;
+    headers.set("Cache-Control", "max-age=3600");
+    headers.set("ETag", "\"v1\"");
+    return headers;
+}
+
+static void store(DiskCache& cache, ByteString const& key, StringView body)
+{
+    auto writer = cache.create_entry_writer(key, 200, {}, cacheable_response_headers(), UnixDateTime::now());
+    VERIFY(writer);
+    writer->append(body.bytes());
+    writer->commit();
+}
+
+static ByteString read_body(DiskCache& cache, ByteString const& key)
+{
+    auto entry = cache.entry_for(key);
+    VERIFY(entry.has_value());
+    auto file = MUST(cache.open_body(*entry));
+    return ByteString { MUST(file->read_until_eof()).bytes() };
+}
+
+static Vector<ByteString> files_in(StringView directory)
+{
+    Vector<ByteString> files;
+    MUST(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        files.append(entry.name);
+        return IterationDecision::Continue;
+    }));
+    return files;
+}
+
+TEST_CASE(concurrent_writers_for_the_same_key)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath { directory->path().to_byte_string() }));
+
+    ByteString key = "https://example.com https://example.com/script.js";
+    auto first = cache->create_entry_writer(key, 200, {}, cacheable_response_headers(), UnixDateTime::now());
+    auto second = cache->create_entry_writer(key, 200, {}, cacheable_response_headers(), UnixDateTime::now());
+    VERIFY(first && second);
+
+    first->append("first "sv.bytes());
+    second->append("second "sv.bytes());
+    first->append("response"sv.bytes());
+    second->append("response"sv.bytes());
+
+    first->commit();
+    EXPECT_EQ(read_body(*cache, key), "first response"sv);
+
+    second->commit();
+    EXPECT_EQ(read_body(*cache, key), "second response"sv);
+    EXPECT_EQ(cache->current_size(), "second response"sv.length());
+
+    first = nullptr;
+    second = nullptr;
+    for (auto const& file_name : files_in(directory->path()))
+        EXPECT(!file_name.contains(".tmp"sv));
+}
+
+TEST_CASE(uncommitted_writer_stores_nothing)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath { directory->path().to_byte_string() }));
+
+    ByteString key = "https://example.com https://example.com/image.png";
+    auto writer = cache->create_entry_writer(key, 200, {}, cacheable_response_headers(), UnixDateTime::now());
+    VERIFY(writer);
+    writer->append("partial"sv.bytes());
+    writer = nullptr;
+
+    EXPECT(!cache->entry_for(key).has_value());
+    for (auto const& file_name : files_in(directory->path()))
+        EXPECT(file_name == "index"sv || file_name == "lock"sv);
+}
+
+TEST_CASE(revalidation)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath { directory->path().to_byte_string() }));
+
+    ByteString key = "https://example.com https://example.com/style.css";
+    store(*cache, key, "p { color: green; }"sv);
+
+    auto entry = cache->entry_for(key);
+    VERIFY(entry.has_value());
+
+    HTTP::HeaderMap request_headers;
+    EXPECT(DiskCache::add_validation_headers(*entry, request_headers));
+    EXPECT_EQ(request_headers.get("If-None-Match").value(), "\"v1\""sv);
+
+    HTTP::HeaderMap not_modified_headers;
+    not_modified_headers.set("Cache-Control", "max-age=60");
+    not_modified_headers.set("Content-Length", "0");
+    cache->freshen_entry_upon_validation(*entry, not_modified_headers, UnixDateTime::now());
+
+    EXPECT_EQ(entry->response_headers.get("Cache-Control").value(), "max-age=60"sv);
+    EXPECT_EQ(entry->response_headers.get("ETag").value(), "\"v1\""sv);
+    EXPECT(!entry->response_headers.contains("Content-Length"));
+    EXPECT_EQ(read_body(*cache, key), "p { color: green; }"sv);
+
+    auto lookup = cache->lookup(key);
+    VERIFY(lookup.has_value());
+    EXPECT_EQ(lookup->freshness, DiskCache::Freshness::Fresh);
+}
+
+TEST_CASE(eviction_in_least_recently_used_order)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath { directory->path().to_byte_string() }, 10));
+
+    store(*cache, "p a", "aaaa"sv);
+    store(*cache, "p b", "bbbb"sv);
+    EXPECT(cache->lookup("p a").has_value());
+
+    store(*cache, "p c", "cccc"sv);
+    EXPECT(cache->entry_for("p a").has_value());
+    EXPECT(!cache->entry_for("p b").has_value());
+    EXPECT(cache->entry_for("p c").has_value());
+    EXPECT_EQ(cache->current_size(), 8u);
+}
+
+TEST_CASE(index_survives_a_restart)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    LexicalPath path { directory->path().to_byte_string() };
+
+    {
+        auto cache = MUST(DiskCache::create(path));
+        store(*cache, "p a", "aaaa"sv);
+        store(*cache, "p b", "bbbb"sv);
+        EXPECT(cache->lookup("p a").has_value());
+        MUST(cache->flush_index());
+    }
+
+    auto cache = MUST(DiskCache::create(path));
+    EXPECT_EQ(read_body(*cache, "p a"), "aaaa"sv);
+    EXPECT_EQ(read_body(*cache, "p b"), "bbbb"sv);
+    EXPECT_EQ(cache->current_size(), 8u);
+}
+
+TEST_CASE(directory_is_locked_against_other_processes)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    LexicalPath path { directory->path().to_byte_string() };
+    auto cache = MUST(DiskCache::create(path));
+    store(*cache, "p a", "aaaa"sv);
+
+    // NOTE: The lock is held by the process, so it can only be observed from another one.
+    auto pid = fork();
+    VERIFY(pid >= 0);
+    if (pid == 0)
+        _exit(DiskCache::create(path).is_error() ? 0 : 1);
+
+    auto result = MUST(Core::System::waitpid(pid));
+    EXPECT(WIFEXITED(result.status));
+    EXPECT_EQ(WEXITSTATUS(result.status), 0);
+
+    EXPECT_EQ(read_body(*cache, "p a"), "aaaa"sv);
+}
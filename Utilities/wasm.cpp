@@ -10,6 +10,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/StackInfo.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibFileSystem/FileSystem.h>
@@ -524,6 +525,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool report_statistics = false;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -539,6 +541,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(report_statistics, "Report the number of executed instructions and the instruction rate", "stats");
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -834,7 +837,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 outln();
             }
 
+            auto executed_instructions_before = g_interpreter.executed_instructions();
+            auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
             auto result = machine.invoke(g_interpreter, run_address.value(), move(values));
+            auto elapsed = timer.elapsed_time();
+
+            if (report_statistics) {
+                auto executed_instructions = g_interpreter.executed_instructions() - executed_instructions_before;
+                auto elapsed_microseconds = max(elapsed.to_microseconds(), 1);
+                warnln("Executed {} instructions in {}ms ({} instructions/sec)",
+                    executed_instructions,
+                    elapsed.to_milliseconds(),
+                    executed_instructions * 1'000'000 / static_cast<u64>(elapsed_microseconds));
+            }
 
             if (debug)
                 launch_repl();